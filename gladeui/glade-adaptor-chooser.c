@@ -143,8 +143,8 @@ on_adaptor_selected (GtkWidget           *widget,
   gtk_popover_popdown (GTK_POPOVER (gtk_widget_get_parent (widget)));
 }
 
-static void
-glade_adaptor_chooser_button_add_chooser (GtkWidget *button, GtkWidget *chooser)
+static GtkPopover *
+glade_adaptor_chooser_button_ensure_popover (GtkWidget *button)
 {
   GtkPopover *popover = gtk_menu_button_get_popover (GTK_MENU_BUTTON (button));
 
@@ -155,6 +155,14 @@ glade_adaptor_chooser_button_add_chooser (GtkWidget *button, GtkWidget *chooser)
                                    GTK_WIDGET (popover));
     }
 
+  return popover;
+}
+
+static void
+glade_adaptor_chooser_button_add_chooser (GtkWidget *button, GtkWidget *chooser)
+{
+  GtkPopover *popover = glade_adaptor_chooser_button_ensure_popover (button);
+
   gtk_container_add (GTK_CONTAINER (popover), chooser);
   gtk_widget_show (chooser);
 }
@@ -295,7 +303,12 @@ glade_adaptor_chooser_constructed (GObject *object)
   gtk_catalog = glade_app_get_catalog ("gtk+");
   button_box_populate_from_catalog (chooser, gtk_catalog);
 
-  update_all_others_chooser (chooser);
+  /* The rest of the catalogs are only listed when first shown, some
+   * of them have to start an interpreter to load their classes.
+   */
+  glade_adaptor_chooser_button_ensure_popover (priv->others_button);
+  glade_adaptor_chooser_button_ensure_popover (priv->all_button);
+  priv->needs_update = TRUE;
 
   g_signal_connect (glade_app_get(), "widget-adaptor-registered",
                     G_CALLBACK (on_widget_adaptor_registered),
@@ -38,6 +38,7 @@ G_DECLARE_DERIVABLE_TYPE (GladeApp, glade_app, GLADE, APP, GObject)
 #define GLADE_ENV_PIXMAP_DIR       "GLADE_PIXMAP_DIR"
 #define GLADE_ENV_ICON_THEME_PATH  "GLADE_ICON_THEME_PATH"
 #define GLADE_ENV_BUNDLED          "GLADE_BUNDLED"
+#define GLADE_ENV_EAGER_INIT       "GLADE_EAGER_INIT"
 
 struct _GladeAppClass
 {
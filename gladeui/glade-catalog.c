@@ -33,6 +33,7 @@
 #include <sys/stat.h>
 #include <glib.h>
 #include <glib/gi18n-lib.h>
+#include <libxml/parser.h>
 
 struct _GladeCatalog
 {
@@ -71,6 +72,9 @@ struct _GladeCatalog
   GladeCatalogInitFunc init_function;
 
   GHashTable *monitors;         /* Dir monitors for user templates catalogs */
+
+  gboolean deferred;            /* Init function and classes are loaded
+                                 * the first time one of them is needed */
 };
 
 struct _GladeWidgetGroup
@@ -89,6 +93,28 @@ static GList *loaded_catalogs = NULL;
 /* Extra paths to load catalogs from */
 static GList *catalog_paths = NULL;
 
+/* Libraries whose init function starts a language interpreter */
+static const gchar *interpreter_libraries[] = { "gladepython", "gladegjs", NULL };
+
+/* Catalogs waiting to be loaded, and their class names */
+static GList *deferred_catalogs = NULL;
+static GHashTable *deferred_classes = NULL;
+
+/* Startup time breakdown, in microseconds (GLADE_DEBUG=catalogs) */
+static struct
+{
+  gint64 parse;                 /* Reading and parsing catalog files  */
+  gint64 open;                  /* Modules, metadata and sorting      */
+  gint64 load;                  /* Init functions and widget groups   */
+  gint64 adaptors;              /* Widget adaptor creation            */
+} load_times;
+
+typedef struct
+{
+  gchar *filename;              /* Catalog file to parse               */
+  GladeXmlContext *context;     /* Parsed document, or NULL on failure */
+} CatalogFile;
+
 static gboolean
 catalog_get_function (GladeCatalog *catalog,
                       const gchar  *symbol_name,
@@ -167,19 +193,16 @@ catalog_destroy (GladeCatalog *catalog)
     g_hash_table_destroy (catalog->monitors);
 }
 
+/* Takes ownership of @context, which was parsed from @filename */
 static GladeCatalog *
-catalog_open (const gchar *filename)
+catalog_open (const gchar *filename, GladeXmlContext *context)
 {
   GladeTargetableVersion *version;
   GladeCatalog *catalog;
-  GladeXmlContext *context;
   GladeXmlDoc *doc;
   GladeXmlNode *root;
   gchar *name;
 
-  /* get the context & root node of the catalog file */
-  context = glade_xml_context_new_from_path (filename,
-                                             NULL, GLADE_TAG_GLADE_CATALOG);
   if (!context)
     {
       g_warning ("Couldn't open catalog [%s].", filename);
@@ -198,7 +221,10 @@ catalog_open (const gchar *filename)
     }
 
   if (!(name = glade_xml_get_property_string_required (root, GLADE_TAG_NAME, NULL)))
-    return NULL;
+    {
+      glade_xml_context_free (context);
+      return NULL;
+    }
 
   catalog = catalog_allocate ();
   catalog->context = context;
@@ -289,12 +315,15 @@ catalog_load_classes (GladeCatalog *catalog, GladeXmlNode *widgets_node)
     {
       const gchar *node_name;
       GladeWidgetAdaptor *adaptor;
+      gint64 start;
 
       node_name = glade_xml_node_get_name (node);
       if (strcmp (node_name, GLADE_TAG_GLADE_WIDGET_CLASS) != 0)
         continue;
 
+      start = g_get_monotonic_time ();
       adaptor = glade_widget_adaptor_from_catalog (catalog, node, module);
+      load_times.adaptors += g_get_monotonic_time () - start;
 
       catalog->adaptors = g_list_prepend (catalog->adaptors, adaptor);
     }
@@ -444,6 +473,138 @@ catalog_find_by_name (GList *catalogs, const gchar *name)
   return NULL;
 }
 
+/* Whether @catalog can wait until one of its classes is needed,
+ * @catalogs are the catalogs already set up before it.
+ */
+static gboolean
+catalog_should_defer (GladeCatalog *catalog, GList *catalogs)
+{
+  GladeCatalog *dep;
+
+  if (g_getenv (GLADE_ENV_EAGER_INIT) != NULL)
+    return FALSE;
+
+  if (catalog->library &&
+      g_strv_contains (interpreter_libraries, catalog->library))
+    return TRUE;
+
+  /* Catalogs extending a deferred catalog have to wait for it */
+  dep = catalog_find_by_name (catalogs, catalog->dep_catalog);
+
+  return dep && dep->deferred;
+}
+
+/* Remembers the class names of @catalog without creating any adaptor,
+ * the catalog document is kept until the catalog is actually loaded.
+ */
+static void
+catalog_defer (GladeCatalog *catalog)
+{
+  GladeXmlNode *root, *node, *class_node;
+
+  if (deferred_classes == NULL)
+    deferred_classes = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
+
+  root = glade_xml_doc_get_root (glade_xml_context_get_doc (catalog->context));
+
+  for (node = glade_xml_node_get_children (root); node;
+       node = glade_xml_node_next (node))
+    {
+      if (strcmp (glade_xml_node_get_name (node), GLADE_TAG_GLADE_WIDGET_CLASSES) != 0)
+        continue;
+
+      for (class_node = glade_xml_node_get_children (node); class_node;
+           class_node = glade_xml_node_next (class_node))
+        {
+          gchar *name;
+
+          if (strcmp (glade_xml_node_get_name (class_node), GLADE_TAG_GLADE_WIDGET_CLASS) != 0 ||
+              (name = glade_xml_get_property_string (class_node, GLADE_TAG_NAME)) == NULL)
+            continue;
+
+          g_hash_table_insert (deferred_classes, name, catalog);
+        }
+    }
+
+  catalog->deferred = TRUE;
+  deferred_catalogs = g_list_prepend (deferred_catalogs, catalog);
+}
+
+static gboolean
+class_is_from_catalog (gpointer key, gpointer value, gpointer catalog)
+{
+  return value == catalog;
+}
+
+/* Runs the init function of a deferred @catalog and creates its adaptors */
+static void
+catalog_load_deferred (GladeCatalog *catalog)
+{
+  GladeCatalog *dep;
+  gint64 start;
+
+  if (!catalog->deferred)
+    return;
+
+  /* Forget about the catalog first, looking up its own classes while
+   * loading it must not try to load it again.
+   */
+  catalog->deferred = FALSE;
+  deferred_catalogs = g_list_remove (deferred_catalogs, catalog);
+  g_hash_table_foreach_remove (deferred_classes, class_is_from_catalog, catalog);
+
+  if ((dep = catalog_find_by_name (deferred_catalogs, catalog->dep_catalog)))
+    catalog_load_deferred (dep);
+
+  start = g_get_monotonic_time ();
+
+  if (catalog->init_function)
+    catalog->init_function (catalog->name);
+
+  catalog_load (catalog);
+
+  GLADE_NOTE (CATALOGS,
+              g_print ("CATALOGS: loaded deferred catalog %s in %.3fs\n",
+                       catalog->name,
+                       (g_get_monotonic_time () - start) / (gdouble) G_USEC_PER_SEC));
+}
+
+/**
+ * _glade_catalog_load_deferred_class:
+ * @name: a class name
+ *
+ * Loads the deferred catalog providing the class @name, if any.
+ *
+ * Returns: whether a catalog was loaded
+ */
+gboolean
+_glade_catalog_load_deferred_class (const gchar *name)
+{
+  GladeCatalog *catalog;
+
+  if (deferred_classes == NULL || name == NULL ||
+      (catalog = g_hash_table_lookup (deferred_classes, name)) == NULL)
+    return FALSE;
+
+  catalog_load_deferred (catalog);
+
+  return TRUE;
+}
+
+/**
+ * _glade_catalog_is_deferred:
+ * @catalog: a catalog object
+ *
+ * Returns: whether @catalog is still waiting for one of its classes to be needed
+ */
+gboolean
+_glade_catalog_is_deferred (GladeCatalog *catalog)
+{
+  g_return_val_if_fail (GLADE_IS_CATALOG (catalog), FALSE);
+
+  return catalog->deferred;
+}
+
 static gint
 catalog_name_cmp (gconstpointer a, gconstpointer b)
 {
@@ -504,23 +665,31 @@ glade_catalog_tsort (GList *catalogs, gboolean loading)
   return sorted;
 }
 
-static GList *
-catalogs_from_path (GList *catalogs, const gchar *path)
+static void
+catalog_file_free (CatalogFile *file)
+{
+  g_free (file->filename);
+  g_clear_pointer (&file->context, glade_xml_context_free);
+  g_slice_free (CatalogFile, file);
+}
+
+/* Collects the catalog files found in @path, in directory order */
+static void
+catalog_files_from_path (GPtrArray *files, const gchar *path)
 {
-  GladeCatalog *catalog;
   GDir *dir;
   GError *error = NULL;
   const gchar *filename;
 
   /* Silent return if the directory didn't exist */
   if (!g_file_test (path, G_FILE_TEST_IS_DIR))
-    return catalogs;
+    return;
 
   if ((dir = g_dir_open (path, 0, &error)) != NULL)
     {
       while ((filename = g_dir_read_name (dir)))
         {
-          gchar *catalog_filename;
+          CatalogFile *file;
 
           if (!g_str_has_suffix (filename, ".xml"))
             continue;
@@ -538,29 +707,86 @@ catalogs_from_path (GList *catalogs, const gchar *path)
               strcmp (filename, "gtk+.xml") != 0)
             continue;
 
-          catalog_filename = g_build_filename (path, filename, NULL);
-          catalog = catalog_open (catalog_filename);
-          g_free (catalog_filename);
-
-          if (catalog)
-            {
-              /* Verify that we are not loading the same catalog twice !
-               */
-              if (catalog_find_by_name (catalogs, catalog->name))
-                catalog_destroy (catalog);
-              else
-                catalogs = g_list_prepend (catalogs, catalog);
-            }
-          else
-            g_warning ("Unable to open the catalog file %s.\n", filename);
+          file = g_slice_new0 (CatalogFile);
+          file->filename = g_build_filename (path, filename, NULL);
+          g_ptr_array_add (files, file);
         }
 
       g_dir_close (dir);
     }
   else
-    g_warning ("Failed to open catalog directory '%s': %s", path,
-               error->message);
+    {
+      g_warning ("Failed to open catalog directory '%s': %s", path,
+                 error->message);
+      g_error_free (error);
+    }
+}
+
+static void
+catalog_file_parse (CatalogFile *file, gpointer user_data)
+{
+  file->context = glade_xml_context_new_from_path (file->filename,
+                                                   NULL, GLADE_TAG_GLADE_CATALOG);
+}
+
+/* Parses every catalog file in @files concurrently, libxml2 documents
+ * are independent from each other once the parser is initialized.
+ */
+static void
+catalog_files_parse (GPtrArray *files)
+{
+  GThreadPool *pool;
+  guint i, n_threads;
+
+  n_threads = MIN (files->len, g_get_num_processors ());
+
+  if (n_threads <= 1 ||
+      !(pool = g_thread_pool_new ((GFunc) catalog_file_parse, NULL,
+                                  n_threads, FALSE, NULL)))
+    {
+      g_ptr_array_foreach (files, (GFunc) catalog_file_parse, NULL);
+      return;
+    }
+
+  /* Make sure the global parser state is set up before using it
+   * from several threads.
+   */
+  xmlInitParser ();
+
+  for (i = 0; i < files->len; i++)
+    g_thread_pool_push (pool, g_ptr_array_index (files, i), NULL);
 
+  /* Wait for all the files to be parsed */
+  g_thread_pool_free (pool, FALSE, TRUE);
+}
+
+/* Opens the parsed catalog files in order, the first catalog found
+ * with a given name wins.
+ */
+static GList *
+catalogs_from_files (GList *catalogs, GPtrArray *files)
+{
+  guint i;
+
+  for (i = 0; i < files->len; i++)
+    {
+      CatalogFile *file = g_ptr_array_index (files, i);
+      GladeCatalog *catalog;
+
+      catalog = catalog_open (file->filename, g_steal_pointer (&file->context));
+
+      if (catalog)
+        {
+          /* Verify that we are not loading the same catalog twice !
+           */
+          if (catalog_find_by_name (catalogs, catalog->name))
+            catalog_destroy (catalog);
+          else
+            catalogs = g_list_prepend (catalogs, catalog);
+        }
+      else
+        g_warning ("Unable to open the catalog file %s.\n", file->filename);
+    }
 
   return catalogs;
 }
@@ -757,6 +983,8 @@ glade_catalog_load_all (void)
   GList *catalogs = NULL, *l, *adaptors;
   GString *icon_warning = NULL;
   const gchar *search_path;
+  gint64 start;
+  GPtrArray *files;
 
   /* Make sure we don't init the catalogs twice */
   if (loaded_catalogs)
@@ -766,6 +994,9 @@ glade_catalog_load_all (void)
       return loaded_catalogs;
     }
 
+  start = g_get_monotonic_time ();
+  files = g_ptr_array_new_with_free_func ((GDestroyNotify) catalog_file_free);
+
   /* First load catalogs from user specified directories ... */
   if ((search_path = g_getenv (GLADE_ENV_CATALOG_PATH)) != NULL)
     {
@@ -776,34 +1007,66 @@ glade_catalog_load_all (void)
           gint i;
 
           for (i = 0; split[i] != NULL; i++)
-            catalogs = catalogs_from_path (catalogs, split[i]);
+            catalog_files_from_path (files, split[i]);
         }
     }
 
   /* ... Then load catalogs from standard install directory */
   if (g_getenv (GLADE_ENV_TESTING) == NULL)
-    catalogs = catalogs_from_path (catalogs, glade_app_get_catalogs_dir ());
+    catalog_files_from_path (files, glade_app_get_catalogs_dir ());
 
   /* And then load catalogs from extra paths */
   for (l = catalog_paths; l; l = g_list_next (l))
-    catalogs = catalogs_from_path (catalogs, l->data);
-  
+    catalog_files_from_path (files, l->data);
+
+  /* Parsing is the expensive part and happens off the main thread,
+   * everything else (modules, init functions and GType registration)
+   * stays here, in dependency order.
+   */
+  catalog_files_parse (files);
+  load_times.parse = g_get_monotonic_time () - start;
+
+  start = g_get_monotonic_time ();
+  catalogs = catalogs_from_files (catalogs, files);
+  g_ptr_array_free (files, TRUE);
+
   /* Catalogs need dependencies, most catalogs depend on
    * the gtk+ catalog, but some custom toolkits may depend
    * on the gnome catalog for instance.
    */
   catalogs = glade_catalog_tsort (catalogs, TRUE);
+  load_times.open = g_get_monotonic_time () - start;
 
-  /* After sorting, execute init function and then load */
+  /* After sorting, execute init function and then load, catalogs
+   * starting an interpreter wait until one of their classes is needed.
+   */
+  start = g_get_monotonic_time ();
+  load_times.adaptors = 0;
   for (l = catalogs; l; l = g_list_next (l))
     {
       GladeCatalog *catalog = l->data;
 
+      if (catalog_should_defer (catalog, catalogs))
+        {
+          catalog_defer (catalog);
+          continue;
+        }
+
       if (catalog->init_function)
         catalog->init_function (catalog->name);
 
       catalog_load (catalog);
     }
+  load_times.load = g_get_monotonic_time () - start - load_times.adaptors;
+
+  GLADE_NOTE (CATALOGS,
+              g_print ("CATALOGS: loaded %u catalogs, parse %.3fs, open %.3fs, "
+                       "load %.3fs, adaptors %.3fs\n",
+                       g_list_length (catalogs),
+                       load_times.parse / (gdouble) G_USEC_PER_SEC,
+                       load_times.open / (gdouble) G_USEC_PER_SEC,
+                       load_times.load / (gdouble) G_USEC_PER_SEC,
+                       load_times.adaptors / (gdouble) G_USEC_PER_SEC));
 
   /* Print a summery of widget adaptors missing icons.
    */
@@ -967,6 +1230,8 @@ glade_catalog_get_widget_groups (GladeCatalog *catalog)
 {
   g_return_val_if_fail (GLADE_IS_CATALOG (catalog), NULL);
 
+  catalog_load_deferred (catalog);
+
   return catalog->widget_groups;
 }
 
@@ -981,6 +1246,8 @@ glade_catalog_get_adaptors (GladeCatalog *catalog)
 {
   g_return_val_if_fail (GLADE_IS_CATALOG (catalog), NULL);
 
+  catalog_load_deferred (catalog);
+
   return catalog->adaptors;
 }
 
@@ -1016,6 +1283,9 @@ glade_catalog_destroy_all (void)
       loaded_catalogs = NULL;
     }
 
+  g_clear_pointer (&deferred_catalogs, g_list_free);
+  g_clear_pointer (&deferred_classes, g_hash_table_destroy);
+
   /* close plugin modules */
   if (modules)
     {
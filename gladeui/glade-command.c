@@ -62,6 +62,8 @@ typedef struct _GladeCommandPrivate
                        * the group id (id is needed only to ensure that
                        * consecutive groups dont get merged).
                        */
+
+  gsize  size;        /* Cached glade_command_get_size() result, 0 if unknown */
 } GladeCommandPrivate;
 
 /* Concerning placeholders: we do not hold any reference to placeholders,
@@ -120,6 +122,65 @@ glade_command_collapse_impl (GladeCommand *this_cmd, GladeCommand *other_cmd)
   g_return_if_reached ();
 }
 
+static gsize
+glade_command_get_size_impl (GladeCommand *command)
+{
+  return 0;
+}
+
+static gsize
+glade_command_instance_size (gpointer instance)
+{
+  GTypeQuery query;
+
+  g_type_query (G_TYPE_FROM_INSTANCE (instance), &query);
+
+  return query.instance_size;
+}
+
+static gsize
+glade_command_value_size (const GValue *value)
+{
+  gsize size = value ? sizeof (GValue) : 0;
+
+  if (value && G_VALUE_HOLDS_STRING (value) && g_value_get_string (value))
+    size += strlen (g_value_get_string (value)) + 1;
+
+  return size;
+}
+
+/* Estimates the memory used by @widget and its whole hierarchy */
+static gsize
+glade_command_widget_size (GladeWidget *widget)
+{
+  GObject *object = glade_widget_get_object (widget);
+  GList *children, *l;
+  gsize size;
+
+  size = glade_command_instance_size (widget);
+
+  if (object)
+    size += glade_command_instance_size (object);
+
+  for (l = glade_widget_get_properties (widget); l; l = l->next)
+    size += glade_command_instance_size (l->data) + sizeof (GValue);
+
+  for (l = glade_widget_get_packing_properties (widget); l; l = l->next)
+    size += glade_command_instance_size (l->data) + sizeof (GValue);
+
+  children = glade_widget_get_children (widget);
+  for (l = children; l; l = l->next)
+    {
+      GladeWidget *child = glade_widget_get_from_gobject (l->data);
+
+      if (child)
+        size += glade_command_widget_size (child);
+    }
+  g_list_free (children);
+
+  return size;
+}
+
 static void
 glade_command_init (GladeCommand *command)
 {
@@ -136,6 +197,7 @@ glade_command_class_init (GladeCommandClass *klass)
   klass->execute = NULL;
   klass->unifies = glade_command_unifies_impl;
   klass->collapse = glade_command_collapse_impl;
+  klass->get_size = glade_command_get_size_impl;
 }
 
 /* Macros for defining the derived command types */
@@ -152,6 +214,8 @@ static gboolean                                                      \
 func ## _unifies (GladeCommand *this_cmd, GladeCommand *other_cmd);  \
 static void                                                          \
 func ## _collapse (GladeCommand *this_cmd, GladeCommand *other_cmd); \
+static gsize                                                         \
+func ## _get_size (GladeCommand *me);                                \
 static void                                                          \
 func ## _class_init (type ## Class *klass)                           \
 {                                                                    \
@@ -161,6 +225,7 @@ func ## _class_init (type ## Class *klass)                           \
   command_class->execute =  func ## _execute;                        \
   command_class->unifies =  func ## _unifies;                        \
   command_class->collapse =  func ## _collapse;                      \
+  command_class->get_size =  func ## _get_size;                      \
   object_class->finalize = func ## _finalize;                        \
 }                                                                    \
 static void                                                          \
@@ -259,8 +324,44 @@ glade_command_unifies (GladeCommand *command, GladeCommand *other)
 void
 glade_command_collapse (GladeCommand *command, GladeCommand *other)
 {
+  GladeCommandPrivate *priv = glade_command_get_instance_private (command);
+
   g_return_if_fail (command);
   GLADE_COMMAND_GET_CLASS (command)->collapse (command, other);
+
+  /* The merged command holds different data now */
+  priv->size = 0;
+}
+
+/**
+ * glade_command_get_size:
+ * @command: A #GladeCommand
+ *
+ * Estimates the memory held by @command for undo purposes, this includes
+ * the values it restores and the widget hierarchies it keeps alive.
+ *
+ * The estimate is computed once and only updated when another command
+ * is collapsed into @command, so it can be used to keep running totals.
+ *
+ * Returns: the estimated size of @command in bytes
+ */
+gsize
+glade_command_get_size (GladeCommand *command)
+{
+  GladeCommandPrivate *priv = glade_command_get_instance_private (command);
+
+  g_return_val_if_fail (GLADE_IS_COMMAND (command), 0);
+
+  if (priv->size == 0)
+    {
+      priv->size = glade_command_instance_size (command) +
+        GLADE_COMMAND_GET_CLASS (command)->get_size (command);
+
+      if (priv->description)
+        priv->size += strlen (priv->description) + 1;
+    }
+
+  return priv->size;
 }
 
 /**
@@ -435,6 +536,12 @@ glade_command_property_enabled_collapse (GladeCommand *this_cmd,
                        glade_widget_get_display_name (widget));
 }
 
+static gsize
+glade_command_property_enabled_get_size (GladeCommand *cmd)
+{
+  return 0;
+}
+
 /**
  * glade_command_set_property_enabled:
  * @property: An optional #GladeProperty
@@ -769,6 +876,25 @@ glade_command_set_property_collapse (GladeCommand *this_cmd,
   other_priv->description = NULL;
 }
 
+static gsize
+glade_command_set_property_get_size (GladeCommand *cmd)
+{
+  GladeCommandSetProperty *me = GLADE_COMMAND_SET_PROPERTY (cmd);
+  GList *l;
+  gsize size = 0;
+
+  for (l = me->sdata; l; l = l->next)
+    {
+      GladeCommandSetPropData *sdata = l->data;
+
+      size += sizeof (GList) + sizeof (GladeCommandSetPropData) +
+        glade_command_value_size (sdata->new_value) +
+        glade_command_value_size (sdata->old_value);
+    }
+
+  return size;
+}
+
 
 #define MAX_UNDO_MENU_ITEM_VALUE_LEN 10
 static gchar *
@@ -1061,6 +1187,15 @@ glade_command_set_name_collapse (GladeCommand *this_cmd,
       g_strdup_printf (_("Renaming %s to %s"), nthis->name, nthis->old_name);
 }
 
+static gsize
+glade_command_set_name_get_size (GladeCommand *cmd)
+{
+  GladeCommandSetName *me = GLADE_COMMAND_SET_NAME (cmd);
+
+  return (me->name ? strlen (me->name) + 1 : 0) +
+    (me->old_name ? strlen (me->old_name) + 1 : 0);
+}
+
 /* this function takes the ownership of name */
 void
 glade_command_set_name (GladeWidget *widget, const gchar *name)
@@ -1693,13 +1828,19 @@ static gboolean
 glade_command_add_remove_execute (GladeCommand *cmd)
 {
   GladeCommandAddRemove *me = (GladeCommandAddRemove *) cmd;
+  GladeCommandPrivate *priv = glade_command_get_instance_private (cmd);
   gboolean retval;
 
+  /* Let views catch up with all the widgets at once */
+  glade_project_begin_bulk_update (priv->project);
+
   if (me->add)
     retval = glade_command_add_execute (me);
   else
     retval = glade_command_remove_execute (me);
 
+  glade_project_end_bulk_update (priv->project);
+
   me->add = !me->add;
 
   return retval;
@@ -1758,6 +1899,29 @@ glade_command_add_remove_collapse (GladeCommand *this_cmd,
   g_return_if_reached ();
 }
 
+static gsize
+glade_command_add_remove_get_size (GladeCommand *cmd)
+{
+  GladeCommandAddRemove *me = GLADE_COMMAND_ADD_REMOVE (cmd);
+  GList *l;
+  gsize size = 0;
+
+  /* Count the widgets whether they are in the project or not, so the
+   * estimate does not change as the command is undone and redone.
+   */
+  for (l = me->widgets; l; l = l->next)
+    {
+      CommandData *cdata = l->data;
+
+      size += sizeof (GList) + sizeof (CommandData);
+
+      if (cdata->widget)
+        size += glade_command_widget_size (cdata->widget);
+    }
+
+  return size;
+}
+
 static void
 adjust_container_size (GladeWidget *parent, gint children)
 {
@@ -1863,15 +2027,22 @@ void
 glade_command_delete (GList *widgets)
 {
   GladeWidget *widget;
+  GladeProject *project;
 
   g_return_if_fail (widgets != NULL);
 
   widget = widgets->data;
+  project = glade_widget_get_project (widget);
+
+  g_return_if_fail (project);
+
+  glade_project_begin_bulk_update (project);
   glade_command_push_group (_("Delete %s"),
                             g_list_length (widgets) == 1 ? 
                             glade_widget_get_display_name (widget) : _("multiple"));
   glade_command_remove (widgets);
   glade_command_pop_group ();
+  glade_project_end_bulk_update (project);
 }
 
 /**
@@ -1884,20 +2055,27 @@ void
 glade_command_cut (GList *widgets)
 {
   GladeWidget *widget;
+  GladeProject *project;
   GList *l;
 
   g_return_if_fail (widgets != NULL);
 
+  widget = widgets->data;
+  project = glade_widget_get_project (widget);
+
+  g_return_if_fail (project);
+
   for (l = widgets; l; l = l->next)
     g_object_set_data (G_OBJECT (l->data), "glade-command-was-cut",
                        GINT_TO_POINTER (TRUE));
 
-  widget = widgets->data;
+  glade_project_begin_bulk_update (project);
   glade_command_push_group (_("Cut %s"),
                             g_list_length (widgets) == 1 ? 
                             glade_widget_get_display_name (widget) : _("multiple"));
   glade_command_remove (widgets);
   glade_command_pop_group ();
+  glade_project_end_bulk_update (project);
 
   glade_clipboard_add (glade_app_get_clipboard (), widgets);
 }
@@ -1998,10 +2176,12 @@ glade_command_paste (GList *widgets,
     }
 
   len = g_list_length (widgets);
+  glade_project_begin_bulk_update (project);
   glade_command_push_group (_("Paste %s"), len == 1 ? glade_widget_get_display_name (copied_widget) : _("multiple"));
   adjust_container_size (parent, len);
   glade_command_add (copied_widgets, parent, placeholder, project, TRUE);
   glade_command_pop_group ();
+  glade_project_end_bulk_update (project);
 
   if (copied_widgets)
     g_list_free (copied_widgets);
@@ -2038,6 +2218,7 @@ glade_command_dnd (GList *widgets,
 
   g_return_if_fail (project);
   
+  glade_project_begin_bulk_update (project);
   glade_command_push_group (_("Drag %s and Drop to %s"),
                             g_list_length (widgets) == 1 ? 
                             glade_widget_get_display_name (widget) : _("multiple"),
@@ -2045,6 +2226,7 @@ glade_command_dnd (GList *widgets,
   glade_command_remove (widgets);
   glade_command_add (widgets, parent, placeholder, project, TRUE);
   glade_command_pop_group ();
+  glade_project_end_bulk_update (project);
 }
 
 /*********************************************************/
@@ -2137,6 +2319,21 @@ glade_command_add_signal_collapse (GladeCommand *this_cmd,
   g_return_if_reached ();
 }
 
+static gsize
+glade_command_add_signal_get_size (GladeCommand *cmd)
+{
+  GladeCommandAddSignal *me = GLADE_COMMAND_ADD_SIGNAL (cmd);
+  gsize size = 0;
+
+  if (me->signal)
+    size += glade_command_instance_size (me->signal);
+
+  if (me->new_signal)
+    size += glade_command_instance_size (me->new_signal);
+
+  return size;
+}
+
 static void
 glade_command_add_remove_change_signal (GladeWidget *glade_widget,
                                         const GladeSignal *signal,
@@ -2336,6 +2533,17 @@ glade_command_set_i18n_collapse (GladeCommand *this_cmd,
   other->old_comment = NULL;
 }
 
+static gsize
+glade_command_set_i18n_get_size (GladeCommand *cmd)
+{
+  GladeCommandSetI18n *me = (GladeCommandSetI18n *) cmd;
+
+  return (me->context ? strlen (me->context) + 1 : 0) +
+    (me->comment ? strlen (me->comment) + 1 : 0) +
+    (me->old_context ? strlen (me->old_context) + 1 : 0) +
+    (me->old_comment ? strlen (me->old_comment) + 1 : 0);
+}
+
 /**
  * glade_command_set_i18n:
  * @property: a #GladeProperty
@@ -2463,6 +2671,12 @@ glade_command_lock_collapse (GladeCommand *this_cmd, GladeCommand *other_cmd)
   /* no unify/collapse */
 }
 
+static gsize
+glade_command_lock_get_size (GladeCommand *cmd)
+{
+  return 0;
+}
+
 /**
  * glade_command_lock_widget:
  * @widget: A #GladeWidget
@@ -2665,6 +2879,14 @@ glade_command_target_collapse (GladeCommand *this_cmd, GladeCommand *other_cmd)
 
 }
 
+static gsize
+glade_command_target_get_size (GladeCommand *cmd)
+{
+  GladeCommandTarget *me = (GladeCommandTarget *) cmd;
+
+  return me->catalog ? strlen (me->catalog) + 1 : 0;
+}
+
 /**
  * glade_command_set_project_target:
  * @project: A #GladeProject
@@ -2886,6 +3108,15 @@ glade_command_property_collapse (GladeCommand *this_cmd, GladeCommand *other_cmd
   glade_command_property_update_description (this_cmd);
 }
 
+static gsize
+glade_command_property_get_size (GladeCommand *cmd)
+{
+  GladeCommandProperty *me = (GladeCommandProperty *) cmd;
+
+  return glade_command_value_size (&me->old_value) +
+    glade_command_value_size (&me->new_value) - 2 * sizeof (GValue);
+}
+
 /**
  * glade_command_set_project_property:
  * @project: A #GladeProject
@@ -61,8 +61,9 @@ struct _GladeCommandClass
   gboolean (* undo)        (GladeCommand *command);
   gboolean (* unifies)     (GladeCommand *command, GladeCommand *other);
   void     (* collapse)    (GladeCommand *command, GladeCommand *other);
+  gsize    (* get_size)    (GladeCommand *command);
 
-  gpointer padding[4];
+  gpointer padding[3];
 };
 
 void                  glade_command_push_group           (const gchar       *fmt,
@@ -78,6 +79,7 @@ gboolean              glade_command_unifies              (GladeCommand      *com
                                                           GladeCommand      *other);
 void                  glade_command_collapse             (GladeCommand      *command,
                                                           GladeCommand      *other);
+gsize                 glade_command_get_size             (GladeCommand      *command);
 
 /************************ project ******************************/
 void           glade_command_set_project_target  (GladeProject *project,
@@ -77,7 +77,9 @@ static const GDebugKey glade_debug_keys[] = {
   { "widget-events", GLADE_DEBUG_WIDGET_EVENTS },
   { "commands",      GLADE_DEBUG_COMMANDS },
   { "properties",    GLADE_DEBUG_PROPERTIES },
-  { "verify",        GLADE_DEBUG_VERIFY }
+  { "verify",        GLADE_DEBUG_VERIFY },
+  { "images",        GLADE_DEBUG_IMAGES },
+  { "catalogs",      GLADE_DEBUG_CATALOGS }
 };
 
 guint
@@ -29,7 +29,9 @@ typedef enum {
   GLADE_DEBUG_WIDGET_EVENTS = (1 << 1),
   GLADE_DEBUG_COMMANDS      = (1 << 2),
   GLADE_DEBUG_PROPERTIES    = (1 << 3),
-  GLADE_DEBUG_VERIFY        = (1 << 4)
+  GLADE_DEBUG_VERIFY        = (1 << 4),
+  GLADE_DEBUG_IMAGES        = (1 << 5),
+  GLADE_DEBUG_CATALOGS      = (1 << 6)
 } GladeDebugFlag;
 
 #ifdef GLADE_ENABLE_DEBUG
@@ -50,6 +50,7 @@
 #include "glade-project.h"
 #include "glade-utils.h"
 #include "glade-editor-property.h"
+#include "glade-private.h"
 
 static void glade_editor_switch_page (GtkNotebook     *notebook,
                                       GtkWidget       *page,
@@ -101,16 +102,17 @@ typedef struct _GladeEditorPrivate
   GladeSignalEditor *signal_editor; /* The signal editor packed into vbox_signals
                                      */
 
-  GList *editables;     /* A list of GladeEditables. We have a widget
-                         * for each GladeWidgetAdaptor and we only load
-                         * them on demand
-                         */
-        
-  GtkWidget *packing_page; /* Packing pages are dynamically created each
-                            * selection, this pointer is only to free
-                            * the last packing page.
-                            */
-  
+  GHashTable *editables; /* A pool of GladeEditables keyed by EditableKey,
+                          * they are created on demand and kept around
+                          * for the next widget of the same class
+                          */
+
+  GtkWidget *page_editables[GLADE_PAGE_QUERY]; /* The editable shown in each page */
+
+  guint stale_pages; /* Pages to load with loaded_widget once they are
+                      * switched to, one bit per GladeEditorPageType
+                      */
+
   gboolean loading; /* Use when loading a GladeWidget into the editor
                      * we set this flag so that we can ignore the
                      * "changed" signal of the name entry text since
@@ -136,6 +138,13 @@ typedef struct _GladeEditorPrivate
   gboolean show_class_field; /* Whether or not to show the class field at the top */
 } GladeEditorPrivate;
 
+typedef struct
+{
+  GladeWidgetAdaptor *adaptor;
+  GladeWidgetAdaptor *parent_adaptor; /* Packing pages only */
+  GladeEditorPageType type;
+} EditableKey;
+
 G_DEFINE_TYPE_WITH_PRIVATE (GladeEditor, glade_editor, GTK_TYPE_BOX)
 
 static GParamSpec *properties[N_PROPERTIES];
@@ -217,7 +226,7 @@ glade_editor_dispose (GObject *object)
   glade_editor_load_widget (editor, NULL);
 
   /* Unref all the cached pages */
-  g_list_free_full (priv->editables, g_object_unref);
+  g_clear_pointer (&priv->editables, g_hash_table_unref);
 
   G_OBJECT_CLASS (glade_editor_parent_class)->dispose (object);
 }
@@ -370,6 +379,49 @@ glade_editor_update_widget_name_cb (GladeWidget *widget,
   glade_editor_update_class_field (editor);
 }
 
+static GladeEditorPageType
+glade_editor_page_type (guint page_num)
+{
+  switch (page_num)
+    {
+    case 0:
+      return GLADE_PAGE_GENERAL;
+    case 1:
+      return GLADE_PAGE_PACKING;
+    case 2:
+      return GLADE_PAGE_COMMON;
+    case 4:
+      return GLADE_PAGE_ATK;
+    default:
+      return GLADE_PAGE_SIGNAL;
+    }
+}
+
+static GtkContainer *
+glade_editor_get_page (GladeEditor *editor, GladeEditorPageType type)
+{
+  GladeEditorPrivate *priv = glade_editor_get_instance_private (editor);
+
+  switch (type)
+    {
+      case GLADE_PAGE_GENERAL:
+        return GTK_CONTAINER (priv->page_widget);
+      case GLADE_PAGE_COMMON:
+        return GTK_CONTAINER (priv->page_common);
+      case GLADE_PAGE_PACKING:
+        return GTK_CONTAINER (priv->page_packing);
+      case GLADE_PAGE_ATK:
+        return GTK_CONTAINER (priv->page_atk);
+      case GLADE_PAGE_QUERY:
+      default:
+        g_critical ("Unreachable code reached !");
+        return NULL;
+    }
+}
+
+static void glade_editor_load_page (GladeEditor        *editor,
+                                    GladeEditorPageType type);
+
 static void
 glade_editor_switch_page (GtkNotebook *notebook,
                           GtkWidget   *page,
@@ -377,6 +429,7 @@ glade_editor_switch_page (GtkNotebook *notebook,
                           GladeEditor *editor)
 {
   GladeEditorPrivate *priv = glade_editor_get_instance_private (editor);
+  GladeEditorPageType type;
 
   gtk_widget_hide (priv->page_widget);
   gtk_widget_hide (priv->page_packing);
@@ -398,6 +451,34 @@ glade_editor_switch_page (GtkNotebook *notebook,
       gtk_widget_show (priv->page_atk);
       break;
     }
+
+  /* Pages are only loaded once they are looked at */
+  type = glade_editor_page_type (page_num);
+  if (type < GLADE_PAGE_QUERY && (priv->stale_pages & (1 << type)))
+    {
+      priv->loading = TRUE;
+      glade_editor_load_page (editor, type);
+      priv->loading = FALSE;
+    }
+}
+
+static guint
+editable_key_hash (gconstpointer data)
+{
+  const EditableKey *key = data;
+
+  return g_direct_hash (key->adaptor) ^
+    (g_direct_hash (key->parent_adaptor) << 1) ^ key->type;
+}
+
+static gboolean
+editable_key_equal (gconstpointer a, gconstpointer b)
+{
+  const EditableKey *key_a = a, *key_b = b;
+
+  return key_a->adaptor == key_b->adaptor &&
+    key_a->parent_adaptor == key_b->parent_adaptor &&
+    key_a->type == key_b->type;
 }
 
 static void
@@ -407,6 +488,8 @@ glade_editor_init (GladeEditor *editor)
   gint                icon_height;
 
   priv->show_class_field = TRUE;
+  priv->editables = g_hash_table_new_full (editable_key_hash, editable_key_equal,
+                                           g_free, g_object_unref);
 
   gtk_widget_init_template (GTK_WIDGET (editor));
 
@@ -416,140 +499,115 @@ glade_editor_init (GladeEditor *editor)
   glade_editor_update_class_field (editor);
 }
 
+/* Packing pages are created by the parent adaptor but are also kept per
+ * child adaptor, since the child class may change the packing properties.
+ */
 static GtkWidget *
 glade_editor_get_editable_by_adaptor (GladeEditor        *editor,
                                       GladeWidgetAdaptor *adaptor,
+                                      GladeWidgetAdaptor *parent_adaptor,
                                       GladeEditorPageType type)
 {
   GladeEditorPrivate *priv = glade_editor_get_instance_private (editor);
+  EditableKey key = { adaptor, parent_adaptor, type };
+  EditableKey *new_key;
   GtkWidget *editable;
-  GList *list;
 
   g_return_val_if_fail (GLADE_IS_WIDGET_ADAPTOR (adaptor), NULL);
 
-  for (list = priv->editables; list; list = list->next)
-    {
-      editable = list->data;
-      if (type !=
-          GPOINTER_TO_INT (g_object_get_data
-                           (G_OBJECT (editable), "glade-editor-page-type")))
-        continue;
-      if (g_object_get_data (G_OBJECT (editable), "glade-widget-adaptor") ==
-          adaptor)
-        return editable;
-    }
+  if ((editable = g_hash_table_lookup (priv->editables, &key)) != NULL)
+    return editable;
 
-  editable = (GtkWidget *) glade_widget_adaptor_create_editable (adaptor, type);
+  editable = (GtkWidget *)
+    glade_widget_adaptor_create_editable (type == GLADE_PAGE_PACKING ? parent_adaptor : adaptor,
+                                          type);
   g_return_val_if_fail (editable != NULL, NULL);
 
   g_object_set_data (G_OBJECT (editable), "glade-editor-page-type",
                      GINT_TO_POINTER (type));
   g_object_set_data (G_OBJECT (editable), "glade-widget-adaptor", adaptor);
 
-  if (type != GLADE_PAGE_PACKING)
-    {
-      priv->editables = g_list_prepend (priv->editables, editable);
-      g_object_ref_sink (editable);
-    }
+  new_key = g_new (EditableKey, 1);
+  *new_key = key;
+  g_hash_table_insert (priv->editables, new_key, g_object_ref_sink (editable));
 
   return editable;
 }
 
+/* Hides the editable of a page, leaving it loaded with nothing so that it
+ * does not wake up on changes to the last widget.
+ */
 static void
-hide_or_remove_visible_child (GtkContainer *container, gboolean remove)
+glade_editor_unload_page (GladeEditor *editor, GladeEditorPageType type)
 {
-  GList *l, *children = gtk_container_get_children (container);
-  GtkWidget *widget;
-
-  for (l = children; l; l = l->next)
-    {
-      widget = l->data;
+  GladeEditorPrivate *priv = glade_editor_get_instance_private (editor);
+  GtkWidget *editable;
 
-      if (gtk_widget_get_visible (widget))
-        {
-          gtk_widget_hide (widget);
+  if ((editable = priv->page_editables[type]) == NULL)
+    return;
 
-          if (remove)
-            gtk_container_remove (container, widget);
+  glade_editable_load (GLADE_EDITABLE (editable), NULL);
+  gtk_widget_hide (editable);
 
-          break;
-        }
-    }
-  g_list_free (children);
+  priv->page_editables[type] = NULL;
 }
 
-static GtkWidget *
-glade_editor_load_editable_in_page (GladeEditor        *editor,
-                                    GladeWidgetAdaptor *adaptor,
-                                    GladeEditorPageType type)
+static void
+glade_editor_load_page (GladeEditor *editor, GladeEditorPageType type)
 {
   GladeEditorPrivate *priv = glade_editor_get_instance_private (editor);
-  GtkContainer *container = NULL;
+  GladeWidgetAdaptor *adaptor, *parent_adaptor = NULL;
+  GladeWidget *widget = priv->loaded_widget, *parent = NULL;
   GtkWidget *scrolled_window, *editable;
+  GtkContainer *container;
   GtkAdjustment *adj;
 
-  /* Remove the old table that was in this container */
-  switch (type)
+  priv->stale_pages &= ~(1 << type);
+
+  /* Use the parenting adaptor for packing pages */
+  if (widget == NULL ||
+      (type == GLADE_PAGE_PACKING && (parent = glade_widget_get_parent (widget)) == NULL))
     {
-      case GLADE_PAGE_GENERAL:
-        container = GTK_CONTAINER (priv->page_widget);
-        break;
-      case GLADE_PAGE_COMMON:
-        container = GTK_CONTAINER (priv->page_common);
-        break;
-      case GLADE_PAGE_PACKING:
-        container = GTK_CONTAINER (priv->page_packing);
-        break;
-      case GLADE_PAGE_ATK:
-        container = GTK_CONTAINER (priv->page_atk);
-        break;
-      case GLADE_PAGE_QUERY:
-      default:
-        g_critical ("Unreachable code reached !");
-        break;
+      glade_editor_unload_page (editor, type);
+      return;
     }
 
-  /* Hide the editable (this will destroy on packing pages) */
-  hide_or_remove_visible_child (container, type == GLADE_PAGE_PACKING);
-
-  if (!adaptor)
-    return NULL;
+  adaptor = glade_widget_get_adaptor (widget);
+  if (type == GLADE_PAGE_PACKING)
+    parent_adaptor = glade_widget_get_adaptor (parent);
 
   if ((editable =
-       glade_editor_get_editable_by_adaptor (editor, adaptor, type)) == NULL)
-    return NULL;
-
-  /* Attach the new page */
-  if (!gtk_widget_get_parent (editable))
-    gtk_container_add (GTK_CONTAINER (container), editable);
-  gtk_widget_show (editable);
+       glade_editor_get_editable_by_adaptor (editor, adaptor, parent_adaptor, type)) == NULL)
+    return;
 
-  if ((scrolled_window = 
-       gtk_widget_get_ancestor (GTK_WIDGET (container), 
-                                GTK_TYPE_SCROLLED_WINDOW)) != NULL)
+  if (editable != priv->page_editables[type])
     {
-      adj = gtk_scrolled_window_get_vadjustment (GTK_SCROLLED_WINDOW (scrolled_window));
-      gtk_container_set_focus_vadjustment (GTK_CONTAINER (editable), adj);
+      glade_editor_unload_page (editor, type);
 
-      adj = gtk_scrolled_window_get_hadjustment (GTK_SCROLLED_WINDOW (scrolled_window));
-      gtk_container_set_focus_hadjustment (GTK_CONTAINER (editable), adj);
-    }
-
-  return editable;
-}
+      container = glade_editor_get_page (editor, type);
 
-static void
-glade_editor_load_widget_class (GladeEditor *editor,
-                                GladeWidgetAdaptor *adaptor)
-{
-  GladeEditorPrivate *priv = glade_editor_get_instance_private (editor);
+      /* Attach the new page */
+      if (!gtk_widget_get_parent (editable))
+        {
+          gtk_container_add (container, editable);
+
+          if ((scrolled_window =
+               gtk_widget_get_ancestor (GTK_WIDGET (container),
+                                        GTK_TYPE_SCROLLED_WINDOW)) != NULL)
+            {
+              adj = gtk_scrolled_window_get_vadjustment (GTK_SCROLLED_WINDOW (scrolled_window));
+              gtk_container_set_focus_vadjustment (GTK_CONTAINER (editable), adj);
+
+              adj = gtk_scrolled_window_get_hadjustment (GTK_SCROLLED_WINDOW (scrolled_window));
+              gtk_container_set_focus_hadjustment (GTK_CONTAINER (editable), adj);
+            }
+        }
 
-  glade_editor_load_editable_in_page (editor, adaptor, GLADE_PAGE_GENERAL);
-  glade_editor_load_editable_in_page (editor, adaptor, GLADE_PAGE_COMMON);
-  glade_editor_load_editable_in_page (editor, adaptor, GLADE_PAGE_ATK);
-  glade_editor_load_editable_in_page (editor, NULL, GLADE_PAGE_PACKING);
+      priv->page_editables[type] = editable;
+    }
 
-  priv->loaded_adaptor = adaptor;
+  glade_editable_load (GLADE_EDITABLE (editable), widget);
+  gtk_widget_show (editable);
 }
 
 static void
@@ -576,76 +634,16 @@ glade_editor_removed_cb (GladeProject *project,
 
 }
 
-
-static void
-glade_editor_load_editable (GladeEditor        *editor,
-                            GladeWidget        *widget,
-                            GladeEditorPageType type)
-{
-  GtkWidget   *editable;
-  GladeWidget *parent = glade_widget_get_parent (widget);
-
-  /* Use the parenting adaptor for packing pages... so deffer creating the widgets
-   * until load time.
-   */
-  if (type == GLADE_PAGE_PACKING)
-    {
-      GladeWidgetAdaptor *adaptor;
-
-      if (!parent)
-        return;
-
-      adaptor = glade_widget_get_adaptor (parent);
-      editable =
-        glade_editor_load_editable_in_page (editor, adaptor,
-                                            GLADE_PAGE_PACKING);
-    }
-  else
-    editable = 
-      glade_editor_get_editable_by_adaptor (editor, 
-                                            glade_widget_get_adaptor (widget), 
-                                            type);
-
-  g_assert (editable);
-
-  if (!widget)
-    gtk_widget_hide (editable);
-
-  glade_editable_load (GLADE_EDITABLE (editable), widget);
-
-  if (widget)
-    gtk_widget_show (editable);
-}
-
-static void
-clear_editables (GladeEditor *editor)
-{
-  GladeEditorPrivate *priv = glade_editor_get_instance_private (editor);
-  GladeEditable *editable;
-  GList *l;
-
-  for (l = priv->editables; l; l = l->next)
-    {
-      editable = l->data;
-      glade_editable_load (editable, NULL);
-    }
-}
-
 static void
 glade_editor_load_widget_real (GladeEditor *editor, GladeWidget *widget)
 {
   GladeEditorPrivate *priv = glade_editor_get_instance_private (editor);
-  GladeWidgetAdaptor *adaptor;
+  GladeEditorPageType type, current;
   GladeProject *project;
 
   /* Disconnect from last widget */
   if (priv->loaded_widget != NULL)
     {
-      /* better pay a small price now and avoid unseen editables
-       * waking up on project metadata changes.
-       */
-      clear_editables (editor);
-
       project = glade_widget_get_project (priv->loaded_widget);
       g_signal_handler_disconnect (G_OBJECT (project),
                                    priv->project_closed_signal_id);
@@ -657,17 +655,17 @@ glade_editor_load_widget_real (GladeEditor *editor, GladeWidget *widget)
                                    priv->widget_name_id);
     }
 
-  /* Load the GladeWidgetAdaptor */
-  adaptor = widget ? glade_widget_get_adaptor (widget) : NULL;
-  if (priv->loaded_adaptor != adaptor || adaptor == NULL)
-    glade_editor_load_widget_class (editor, adaptor);
+  priv->loaded_adaptor = widget ? glade_widget_get_adaptor (widget) : NULL;
+  priv->loaded_widget = widget;
 
   glade_signal_editor_load_widget (priv->signal_editor, widget);
 
   /* we are just clearing, we are done */
   if (widget == NULL)
     {
-      priv->loaded_widget = NULL;
+      for (type = GLADE_PAGE_GENERAL; type < GLADE_PAGE_QUERY; type++)
+        glade_editor_unload_page (editor, type);
+      priv->stale_pages = 0;
 
       /* Clear class header */
       glade_editor_update_class_field (editor);
@@ -679,13 +677,23 @@ glade_editor_load_widget_real (GladeEditor *editor, GladeWidget *widget)
 
   priv->loading = TRUE;
 
-  /* Load each GladeEditorProperty from 'widget' */
-  glade_editor_load_editable (editor, widget, GLADE_PAGE_GENERAL);
-  glade_editor_load_editable (editor, widget, GLADE_PAGE_COMMON);
-  glade_editor_load_editable (editor, widget, GLADE_PAGE_ATK);
-  glade_editor_load_editable (editor, widget, GLADE_PAGE_PACKING);
+  /* Load the page in view, the other ones are loaded when switched to.
+   * Better pay a small price now and avoid unseen editables waking up
+   * on project metadata changes.
+   */
+  current = glade_editor_page_type (gtk_notebook_get_current_page (GTK_NOTEBOOK (priv->notebook)));
+
+  for (type = GLADE_PAGE_GENERAL; type < GLADE_PAGE_QUERY; type++)
+    {
+      if (type == current)
+        glade_editor_load_page (editor, type);
+      else
+        {
+          glade_editor_unload_page (editor, type);
+          priv->stale_pages |= 1 << type;
+        }
+    }
 
-  priv->loaded_widget = widget;
   priv->loading = FALSE;
 
   /* Update class header */
@@ -712,6 +720,20 @@ glade_editor_load_widget_real (GladeEditor *editor, GladeWidget *widget)
 }
 
 
+/* The editable loaded in the @type page, %NULL if the page has not been
+ * loaded yet or has nothing to show.
+ */
+GtkWidget *
+_glade_editor_get_page_editable (GladeEditor *editor, GladeEditorPageType type)
+{
+  GladeEditorPrivate *priv = glade_editor_get_instance_private (editor);
+
+  g_return_val_if_fail (GLADE_IS_EDITOR (editor), NULL);
+  g_return_val_if_fail (type < GLADE_PAGE_QUERY, NULL);
+
+  return priv->page_editables[type];
+}
+
 /**
  * glade_editor_new:
  *
@@ -63,6 +63,9 @@ static void     search_entry_text_deleted_cb  (GtkEditable    *editable,
                                                gint            end_pos,
                                                GladeInspector *inspector);
 
+/* How long the search waits for more keystrokes before filtering */
+#define SEARCH_DEBOUNCE_MS 150
+
 enum
 {
   PROP_0,
@@ -89,8 +92,18 @@ typedef struct _GladeInspectorPrivate
   gboolean search_disabled;
   gchar *completion_text;
   gchar *completion_text_fold;
+
+  guint refilter_id;
+  gchar *search_fold;          /* The query the visibility in search_cache is for */
+  GHashTable *search_cache;    /* GladeWidget -> SearchEntry */
 } GladeInspectorPrivate;
 
+typedef struct
+{
+  gchar    *name_fold;         /* The casefolded widget name */
+  gboolean  visible;           /* Whether the widget or one of its children matched */
+} SearchEntry;
+
 static GParamSpec *properties[N_PROPERTIES];
 static guint glade_inspector_signals[LAST_SIGNAL] = { 0 };
 
@@ -197,60 +210,165 @@ glade_inspector_class_init (GladeInspectorClass *klass)
   g_object_class_install_properties (object_class, N_PROPERTIES, properties);
 }
 
-static gboolean
-glade_inspector_visible_func (GtkTreeModel *model,
-                              GtkTreeIter  *parent,
-                              gpointer      data)
+static void
+search_entry_free (SearchEntry *entry)
+{
+  g_free (entry->name_fold);
+  g_free (entry);
+}
+
+static SearchEntry *
+search_entry_lookup (GladeInspector *inspector,
+                     GtkTreeModel   *model,
+                     GtkTreeIter    *iter,
+                     gboolean        create)
 {
-  GladeInspector *inspector = data;
   GladeInspectorPrivate *priv = glade_inspector_get_instance_private (inspector);
+  g_autoptr(GObject) object = NULL;
+  GladeWidget *widget;
+  SearchEntry *entry;
 
-  GtkTreeIter iter;
+  gtk_tree_model_get (model, iter, GLADE_PROJECT_MODEL_COLUMN_OBJECT, &object, -1);
 
-  gboolean retval = FALSE;
+  if ((widget = glade_widget_get_from_gobject (object)) == NULL)
+    return NULL;
 
-  if (priv->search_disabled || priv->completion_text == NULL)
-    return TRUE;
+  if ((entry = g_hash_table_lookup (priv->search_cache, widget)) == NULL && create)
+    {
+      entry = g_new0 (SearchEntry, 1);
+      entry->name_fold = g_utf8_casefold (glade_widget_get_name (widget), -1);
+
+      /* Not filtered out yet, an incremental search has to look at it */
+      entry->visible = TRUE;
+
+      g_hash_table_insert (priv->search_cache, widget, entry);
+    }
+
+  return entry;
+}
+
+/* Updates the visibility of @iter and its children for @needle, children
+ * first. With @incremental the previous query is a part of @needle, so
+ * whatever was filtered out before stays filtered out.
+ */
+static gboolean
+search_update_iter (GladeInspector *inspector,
+                    GtkTreeModel   *model,
+                    GtkTreeIter    *iter,
+                    const gchar    *needle,
+                    gboolean        incremental)
+{
+  SearchEntry *entry;
+  GtkTreeIter child;
+  gboolean visible = FALSE;
+
+  if ((entry = search_entry_lookup (inspector, model, iter, TRUE)) == NULL)
+    return FALSE;
 
-  if (gtk_tree_model_iter_children (model, &iter, parent))
+  if (incremental && !entry->visible)
+    return FALSE;
+
+  if (gtk_tree_model_iter_children (model, &child, iter))
     {
       do
         {
-          retval = glade_inspector_visible_func (model, &iter, data);
+          if (search_update_iter (inspector, model, &child, needle, incremental))
+            visible = TRUE;
         }
-      while (gtk_tree_model_iter_next (model, &iter) && !retval);
+      while (gtk_tree_model_iter_next (model, &child));
     }
 
-  if (!retval)
-    {
-      gchar *widget_name, *haystack;
+  entry->visible = visible || strstr (entry->name_fold, needle) != NULL;
 
-      gtk_tree_model_get (model, parent, GLADE_PROJECT_MODEL_COLUMN_NAME,
-                          &widget_name, -1);
+  return entry->visible;
+}
 
-      haystack = g_utf8_casefold (widget_name, -1);
+static void
+glade_inspector_search_update (GladeInspector *inspector)
+{
+  GladeInspectorPrivate *priv = glade_inspector_get_instance_private (inspector);
+  GtkTreeModel *model = GTK_TREE_MODEL (priv->project);
+  const gchar *needle = priv->completion_text_fold;
+  gboolean incremental;
+  GtkTreeIter iter;
+
+  if (priv->project == NULL || needle == NULL)
+    return;
 
-      retval = strstr (haystack, priv->completion_text_fold) != NULL;
+  incremental = priv->search_fold && strstr (needle, priv->search_fold) != NULL;
 
-      g_free (haystack);
-      g_free (widget_name);
+  if (gtk_tree_model_get_iter_first (model, &iter))
+    {
+      do
+        search_update_iter (inspector, model, &iter, needle, incremental);
+      while (gtk_tree_model_iter_next (model, &iter));
     }
 
-  return retval;
+  g_free (priv->search_fold);
+  priv->search_fold = g_strdup (needle);
+}
+
+static gboolean
+glade_inspector_visible_func (GtkTreeModel *model,
+                              GtkTreeIter  *iter,
+                              gpointer      data)
+{
+  GladeInspector *inspector = data;
+  GladeInspectorPrivate *priv = glade_inspector_get_instance_private (inspector);
+  SearchEntry *entry;
+
+  if (priv->search_disabled || priv->completion_text == NULL)
+    return TRUE;
+
+  /* Rows added since the last pass show until the next one */
+  if ((entry = search_entry_lookup (inspector, model, iter, FALSE)) == NULL)
+    return TRUE;
+
+  return entry->visible;
 }
 
 static void
-glade_inspector_refilter (GladeInspector *inspector)
+glade_inspector_refilter_now (GladeInspector *inspector)
 {
   GladeInspectorPrivate *priv = glade_inspector_get_instance_private (inspector);
 
-  if (!priv->search_disabled)
+  g_clear_handle_id (&priv->refilter_id, g_source_remove);
+
+  if (!priv->search_disabled && priv->filter)
     {
+      glade_inspector_search_update (inspector);
       gtk_tree_model_filter_refilter (GTK_TREE_MODEL_FILTER (priv->filter));
       gtk_tree_view_expand_all (GTK_TREE_VIEW (priv->view));
     }
 }
 
+static gboolean
+glade_inspector_refilter_timeout (gpointer data)
+{
+  GladeInspector *inspector = data;
+  GladeInspectorPrivate *priv = glade_inspector_get_instance_private (inspector);
+
+  priv->refilter_id = 0;
+  glade_inspector_refilter_now (inspector);
+
+  return G_SOURCE_REMOVE;
+}
+
+/* Filters once the user stopped typing for a moment */
+static void
+glade_inspector_refilter (GladeInspector *inspector)
+{
+  GladeInspectorPrivate *priv = glade_inspector_get_instance_private (inspector);
+
+  if (priv->search_disabled)
+    return;
+
+  g_clear_handle_id (&priv->refilter_id, g_source_remove);
+  priv->refilter_id = g_timeout_add (SEARCH_DEBOUNCE_MS,
+                                     glade_inspector_refilter_timeout,
+                                     inspector);
+}
+
 static void
 search_entry_changed_cb (GtkEntry *entry, GladeInspector *inspector)
 {
@@ -353,6 +471,7 @@ inspector_set_completion_text (GladeInspector *inspector, const gchar *text)
   GladeInspectorPrivate *priv = glade_inspector_get_instance_private (inspector);
 
   g_free (priv->completion_text);
+  g_free (priv->completion_text_fold);
   priv->completion_text = g_strdup (text);
   priv->completion_text_fold = text ? g_utf8_casefold (text, -1) : NULL;
 
@@ -449,7 +568,7 @@ search_entry_key_press_event_cb (GtkEntry       *entry,
           gtk_editable_set_position (GTK_EDITABLE (entry), -1);
           gtk_editable_select_region (GTK_EDITABLE (entry), -1, -1);
 
-          glade_inspector_refilter (inspector);
+          glade_inspector_refilter_now (inspector);
         }
       return TRUE;
     }
@@ -477,7 +596,7 @@ search_entry_key_press_event_cb (GtkEntry       *entry,
           gtk_editable_set_position (GTK_EDITABLE (entry), -1);
           gtk_editable_select_region (GTK_EDITABLE (entry), -1, -1);
 
-          glade_inspector_refilter (inspector);
+          glade_inspector_refilter_now (inspector);
 
           widget = glade_project_get_widget_by_name (priv->project, priv->completion_text);
           if (widget)
@@ -541,12 +660,14 @@ search_entry_focus_out_cb (GtkWidget      *entry,
   GladeInspectorPrivate *priv = glade_inspector_get_instance_private (inspector);
 
   priv->search_disabled = TRUE;
+  g_clear_handle_id (&priv->refilter_id, g_source_remove);
 
   inspector_set_completion_text (inspector, NULL);
 
   gtk_entry_set_text (GTK_ENTRY (priv->entry), "");
 
-  gtk_tree_model_filter_refilter (GTK_TREE_MODEL_FILTER (priv->filter));
+  if (priv->filter)
+    gtk_tree_model_filter_refilter (GTK_TREE_MODEL_FILTER (priv->filter));
 
   return FALSE;
 }
@@ -562,6 +683,8 @@ glade_inspector_init (GladeInspector *inspector)
                                   GTK_ORIENTATION_VERTICAL);
 
   priv->project = NULL;
+  priv->search_cache = g_hash_table_new_full (NULL, NULL, NULL,
+                                              (GDestroyNotify) search_entry_free);
 
   priv->entry = gtk_entry_new ();
 
@@ -636,6 +759,8 @@ glade_inspector_dispose (GObject *object)
       priv->idle_complete = 0;
     }
 
+  g_clear_handle_id (&priv->refilter_id, g_source_remove);
+
   G_OBJECT_CLASS (glade_inspector_parent_class)->dispose (object);
 }
 
@@ -647,6 +772,8 @@ glade_inspector_finalize (GObject *object)
 
   g_free (priv->completion_text);
   g_free (priv->completion_text_fold);
+  g_free (priv->search_fold);
+  g_hash_table_destroy (priv->search_cache);
 
   G_OBJECT_CLASS (glade_inspector_parent_class)->finalize (object);
 }
@@ -738,7 +865,7 @@ static void
 selection_changed_cb (GtkTreeSelection *selection, GladeInspector *inspector)
 {
   GladeInspectorPrivate *priv = glade_inspector_get_instance_private (inspector);
-  GList *sel = NULL, *l;
+  GList *sel = NULL;
 
   gtk_tree_selection_selected_foreach (selection,
                                        (GtkTreeSelectionForeachFunc)
@@ -761,8 +888,7 @@ selection_changed_cb (GtkTreeSelection *selection, GladeInspector *inspector)
                                    inspector);
 
   glade_project_selection_clear (priv->project, FALSE);
-  for (l = sel; l; l = l->next)
-    glade_project_selection_add (priv->project, G_OBJECT (l->data), FALSE);
+  glade_project_selection_add_many (priv->project, sel, FALSE);
   glade_project_selection_changed (priv->project);
   g_list_free (sel);
 
@@ -982,6 +1108,47 @@ add_columns (GtkTreeView *view)
   gtk_tree_view_set_headers_visible (view, FALSE);
 }
 
+static void
+project_widget_name_changed_cb (GladeProject   *project,
+                                GladeWidget    *widget,
+                                GladeInspector *inspector)
+{
+  GladeInspectorPrivate *priv = glade_inspector_get_instance_private (inspector);
+  SearchEntry *entry;
+
+  if ((entry = g_hash_table_lookup (priv->search_cache, widget)) != NULL)
+    {
+      g_free (entry->name_fold);
+      entry->name_fold = g_utf8_casefold (glade_widget_get_name (widget), -1);
+    }
+
+  /* The widget may match now, which no incremental search would notice */
+  g_clear_pointer (&priv->search_fold, g_free);
+
+  if (priv->completion_text)
+    glade_inspector_refilter (inspector);
+}
+
+static void
+project_objects_changed_cb (GladeProject   *project,
+                            GPtrArray      *added,
+                            GPtrArray      *removed,
+                            GladeInspector *inspector)
+{
+  GladeInspectorPrivate *priv = glade_inspector_get_instance_private (inspector);
+  guint i;
+
+  for (i = 0; i < removed->len; i++)
+    g_hash_table_remove (priv->search_cache, g_ptr_array_index (removed, i));
+
+  /* New rows are not filtered yet */
+  if (added->len)
+    g_clear_pointer (&priv->search_fold, g_free);
+
+  if (priv->completion_text)
+    glade_inspector_refilter (inspector);
+}
+
 static void
 disconnect_project_signals (GladeInspector *inspector, GladeProject *project)
 {
@@ -989,6 +1156,13 @@ disconnect_project_signals (GladeInspector *inspector, GladeProject *project)
                                         G_CALLBACK
                                         (project_selection_changed_cb),
                                         inspector);
+  g_signal_handlers_disconnect_by_func (G_OBJECT (project),
+                                        G_CALLBACK
+                                        (project_widget_name_changed_cb),
+                                        inspector);
+  g_signal_handlers_disconnect_by_func (G_OBJECT (project),
+                                        G_CALLBACK (project_objects_changed_cb),
+                                        inspector);
 }
 
 static void
@@ -996,6 +1170,10 @@ connect_project_signals (GladeInspector *inspector, GladeProject *project)
 {
   g_signal_connect (G_OBJECT (project), "selection-changed",
                     G_CALLBACK (project_selection_changed_cb), inspector);
+  g_signal_connect (G_OBJECT (project), "widget-name-changed",
+                    G_CALLBACK (project_widget_name_changed_cb), inspector);
+  g_signal_connect (G_OBJECT (project), "objects-changed",
+                    G_CALLBACK (project_objects_changed_cb), inspector);
 }
 
 /**
@@ -1025,6 +1203,9 @@ glade_inspector_set_project (GladeInspector *inspector, GladeProject *project)
       gtk_tree_view_set_model (GTK_TREE_VIEW (priv->view), NULL);
       priv->filter = NULL;
       priv->project = NULL;
+
+      g_hash_table_remove_all (priv->search_cache);
+      g_clear_pointer (&priv->search_fold, g_free);
     }
 
   if (project)
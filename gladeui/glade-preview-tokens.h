@@ -7,5 +7,19 @@
 #define QUIT_TOKEN "<quit>\n"
 #define QUIT_TOKEN_SIZE strlen (QUIT_TOKEN)
 
-#endif /* __GLADE_PREVIEW_TOKENS_H__ */
+/* With --framed every message is a "<kind> <length>\n" header followed by
+ * exactly <length> bytes of payload, whose first line is the message key.
+ */
+#define FRAME_HEADER_FMT "%s %" G_GSIZE_FORMAT "\n"
+
+/* A piece of UI definition, keyed by the SHA1 of its contents */
+#define FRAME_CHUNK "chunk"
+
+/* Keyed by the toplevel to preview, the rest of the payload lists the
+ * hashes of the chunks making up the UI definition in order, one per line.
+ */
+#define FRAME_UPDATE "update"
 
+#define FRAME_QUIT "quit"
+
+#endif /* __GLADE_PREVIEW_TOKENS_H__ */
@@ -44,6 +44,7 @@
 #include "glade-preview.h"
 #include "glade-project.h"
 #include "glade-app.h"
+#include "glade-private.h"
 
 #include "glade-preview-tokens.h"
 
@@ -60,6 +61,7 @@ struct _GladePreviewPrivate
   guint watch;                  /* Event source id used to monitor the channel */
   GladeWidget *previewed_widget;
   GPid pid;                     /* Pid of the corresponding glade-previewer process */
+  GStrv hashes;                 /* Chunks of the last update, the only ones the previewer keeps */
 };
 
 G_DEFINE_TYPE_WITH_PRIVATE (GladePreview, glade_preview, G_TYPE_OBJECT)
@@ -72,30 +74,71 @@ enum
 
 static guint glade_preview_signals[LAST_SIGNAL] = { 0 };
 
+static void
+glade_preview_write (GladePreview *preview, const gchar *data, gsize length)
+{
+  GError *error = NULL;
+  gsize bytes_written;
+
+  g_io_channel_write_chars (preview->priv->channel, data, length,
+                            &bytes_written, &error);
+
+  if (bytes_written != length && error != NULL)
+    {
+      g_warning ("Error passing UI trough pipe: %s", error->message);
+      g_error_free (error);
+    }
+}
+
+/* Writes a frame whose payload is @key followed by a newline and @data */
+static void
+glade_preview_write_frame (GladePreview *preview,
+                           const gchar  *kind,
+                           const gchar  *key,
+                           const gchar  *data)
+{
+  gsize key_length = strlen (key), data_length = strlen (data);
+  gchar *header;
+
+  header = g_strdup_printf (FRAME_HEADER_FMT, kind, key_length + 1 + data_length);
+
+  glade_preview_write (preview, header, strlen (header));
+  glade_preview_write (preview, key, key_length);
+  glade_preview_write (preview, "\n", 1);
+  glade_preview_write (preview, data, data_length);
+
+  g_free (header);
+}
+
+static void
+glade_preview_flush (GladePreview *preview)
+{
+  GError *error = NULL;
+
+  g_io_channel_flush (preview->priv->channel, &error);
+  if (error != NULL)
+    {
+      g_warning ("Error flushing UI trough pipe: %s", error->message);
+      g_error_free (error);
+    }
+}
+
 /**
  * glade_preview_kill
  * @preview: a #GladePreview that will be killed.
  *
- * Uses the communication channel and protocol to send the "<quit>" token to the
+ * Uses the communication channel and protocol to send a quit frame to the
  * glade-previewer telling it to commit suicide.
  *
  */
 static void
 glade_preview_kill (GladePreview *preview)
 {
-  const gchar *quit = QUIT_TOKEN;
   GIOChannel *channel;
   GError *error = NULL;
-  gsize size;
 
   channel = preview->priv->channel;
-  g_io_channel_write_chars (channel, quit, strlen (quit), &size, &error);
-
-  if (size != strlen (quit) && error != NULL)
-    {
-      g_warning ("Error passing quit signal trough pipe: %s", error->message);
-      g_error_free (error);
-    }
+  glade_preview_write_frame (preview, FRAME_QUIT, "", "");
 
   g_io_channel_flush (channel, &error);
   if (error != NULL)
@@ -136,6 +179,10 @@ glade_preview_dispose (GObject *gobject)
 static void
 glade_preview_finalize (GObject *gobject)
 {
+  GladePreview *self = GLADE_PREVIEW (gobject);
+
+  g_strfreev (self->priv->hashes);
+
   G_OBJECT_CLASS (glade_preview_parent_class)->finalize (gobject);
 }
 
@@ -185,7 +232,8 @@ glade_preview_internal_watch (GPid pid, gint status, gpointer data)
 /**
  * glade_preview_launch:
  * @widget: Pointer to a local instance of the widget that will be previewed.
- * @buffer: Contents of an xml definition of the interface which will be previewed
+ * @buffer: (nullable): Contents of an xml definition of the interface which
+ *          will be previewed, or %NULL to send it later with glade_preview_update()
  *
  * Creates a new #GladePreview and launches glade-previewer to preview it.
  *
@@ -197,9 +245,8 @@ glade_preview_launch (GladeWidget *widget, const gchar *buffer)
 {
   GPid pid;
   GError *error = NULL;
-  gchar *argv[10], *executable;
+  gchar *argv[11], *executable;
   gint child_stdin;
-  gsize bytes_written;
   GIOChannel *output;
   GladePreview *preview = NULL;
   const gchar *css_provider, *filename;
@@ -217,12 +264,13 @@ glade_preview_launch (GladeWidget *widget, const gchar *buffer)
   
   argv[0] = executable;
   argv[1] = "--listen";
-  argv[2] = "--toplevel";
-  argv[3] = (gchar *) glade_widget_get_name (widget);
-  argv[4] = "--filename";
-  argv[5] = (filename) ? (gchar *) filename : name;
+  argv[2] = "--framed";
+  argv[3] = "--toplevel";
+  argv[4] = (gchar *) glade_widget_get_name (widget);
+  argv[5] = "--filename";
+  argv[6] = (filename) ? (gchar *) filename : name;
 
-  i = 5;
+  i = 6;
   if (glade_project_get_template (project))
     argv[++i] = "--template";
     
@@ -259,21 +307,8 @@ glade_preview_launch (GladeWidget *widget, const gchar *buffer)
   output = g_io_channel_unix_new (child_stdin);
 #endif
 
-  g_io_channel_write_chars (output, buffer, strlen (buffer), &bytes_written,
-                            &error);
-
-  if (bytes_written != strlen (buffer) && error != NULL)
-    {
-      g_warning ("Error passing UI trough pipe: %s", error->message);
-      g_error_free (error);
-    }
-
-  g_io_channel_flush (output, &error);
-  if (error != NULL)
-    {
-      g_warning ("Error flushing UI trough pipe: %s", error->message);
-      g_error_free (error);
-    }
+  /* Frame lengths are in bytes */
+  g_io_channel_set_encoding (output, NULL, NULL);
 
   /* Setting up preview data */
   preview                         = g_object_new (GLADE_TYPE_PREVIEW, NULL);
@@ -289,62 +324,83 @@ glade_preview_launch (GladeWidget *widget, const gchar *buffer)
   g_free (executable);
   g_free (name);
 
+  if (buffer)
+    glade_preview_update (preview, buffer);
+
   return preview;
 }
 
+/**
+ * glade_preview_update:
+ * @preview: a #GladePreview
+ * @buffer: Contents of an xml definition of the interface which will be previewed
+ *
+ * Replaces the interface shown by @preview with @buffer.
+ */
 void
 glade_preview_update (GladePreview *preview, const gchar  *buffer)
 {
-  const gchar *update_token = UPDATE_TOKEN;
-  gchar *update;
-  GIOChannel *channel;
-  GError *error = NULL;
-  gsize size;
-  gsize bytes_written;
-  GladeWidget *gwidget;
+  GPtrArray *chunks;
 
   g_return_if_fail (GLADE_IS_PREVIEW (preview));
   g_return_if_fail (buffer && buffer[0]);
 
-  gwidget = glade_preview_get_widget (preview);
-
-  update = g_strdup_printf ("%s%s\n", update_token,
-                            glade_widget_get_name (gwidget));
+  chunks = g_ptr_array_new ();
+  g_ptr_array_add (chunks, (gpointer) buffer);
+  _glade_preview_update_chunks (preview, chunks, TRUE);
+  g_ptr_array_unref (chunks);
+}
 
-  channel = preview->priv->channel;
-  g_io_channel_write_chars (channel, update, strlen (update), &size, &error);
+/* Sends the interface made of @chunks concatenated in order, the chunks
+ * the previewer still has from the last update are only sent by hash.
+ * If no chunk changed nothing is sent at all unless @present is %TRUE,
+ * in which case the previewer is brought to front anyway.
+ */
+void
+_glade_preview_update_chunks (GladePreview *preview,
+                              GPtrArray    *chunks,
+                              gboolean      present)
+{
+  GladePreviewPrivate *priv;
+  GStrv hashes;
+  gchar *list;
+  guint i;
 
-  if (size != strlen (update) && error != NULL)
-    {
-      g_warning ("Error passing quit signal trough pipe: %s", error->message);
-      g_error_free (error);
-    }
+  g_return_if_fail (GLADE_IS_PREVIEW (preview));
+  g_return_if_fail (chunks != NULL);
 
-  g_io_channel_flush (channel, &error);
-  if (error != NULL)
-    {
-      g_warning ("Error flushing channel: %s", error->message);
-      g_error_free (error);
-    }
+  priv = preview->priv;
+  hashes = g_new0 (gchar *, chunks->len + 1);
 
-  /* We'll now send the interface: */
-  g_io_channel_write_chars (channel, buffer, strlen (buffer), &bytes_written,
-                            &error);
+  for (i = 0; i < chunks->len; i++)
+    hashes[i] = g_compute_checksum_for_string (G_CHECKSUM_SHA1,
+                                               g_ptr_array_index (chunks, i), -1);
 
-  if (bytes_written != strlen (buffer) && error != NULL)
+  if (!present && priv->hashes && g_strv_equal ((const gchar * const *) hashes,
+                                                (const gchar * const *) priv->hashes))
     {
-      g_warning ("Error passing UI trough pipe: %s", error->message);
-      g_error_free (error);
+      g_strfreev (hashes);
+      return;
     }
 
-  g_io_channel_flush (channel, &error);
-  if (error != NULL)
+  for (i = 0; i < chunks->len; i++)
     {
-      g_warning ("Error flushing UI trough pipe: %s", error->message);
-      g_error_free (error);
+      if (priv->hashes && g_strv_contains ((const gchar * const *) priv->hashes, hashes[i]))
+        continue;
+
+      glade_preview_write_frame (preview, FRAME_CHUNK, hashes[i],
+                                 g_ptr_array_index (chunks, i));
     }
 
-  g_free (update);
+  list = g_strjoinv ("\n", hashes);
+  glade_preview_write_frame (preview, FRAME_UPDATE,
+                             glade_widget_get_name (priv->previewed_widget),
+                             list);
+  glade_preview_flush (preview);
+  g_free (list);
+
+  g_strfreev (priv->hashes);
+  priv->hashes = hashes;
 }
 
 GladeWidget *
@@ -24,6 +24,7 @@
 #include <gladeui/glade.h>
 
 #include <stdlib.h>
+#include <string.h>
 #include <locale.h>
 #include <glib/gi18n-lib.h>
 #include <glib/gstdio.h>
@@ -37,6 +38,9 @@ typedef struct
   GladePreviewer *preview;
   gchar *file_name, *toplevel;
   gboolean is_template;
+
+  GHashTable *chunks;           /* UI definition chunks received with --framed, by hash */
+  GStrv hashes;                 /* Chunks the current widget was built from */
 } GladePreviewerApp;
 
 static GObject *
@@ -261,6 +265,166 @@ on_data_incoming (GIOChannel *source, GIOCondition condition, gpointer data)
   return TRUE;
 }
 
+static void
+read_failed (GError *error)
+{
+  if (error)
+    {
+      g_printerr (_("Error: %s.\n"), error->message);
+      g_error_free (error);
+    }
+  else
+    g_printerr (_("Broken pipe!\n"));
+
+  exit (1);
+}
+
+/* Reads a frame header and its payload, returns the frame kind and
+ * sets @key to the first line of the payload and @data to the rest.
+ * Both are part of the same allocation, owned by @key.
+ */
+static gchar *
+read_frame (GIOChannel *source, gchar **key, gchar **data)
+{
+  gchar *header, *length_str, *payload, *newline;
+  gsize bytes_read, total = 0;
+  GError *error = NULL;
+  guint64 length;
+
+  if (g_io_channel_read_line (source, &header, NULL, NULL, &error) != G_IO_STATUS_NORMAL)
+    read_failed (error);
+
+  g_strchomp (header);
+
+  if (!(length_str = strrchr (header, ' ')) ||
+      !g_ascii_string_to_unsigned (length_str + 1, 10, 1, G_MAXSIZE, &length, NULL))
+    {
+      g_printerr (_("Error: malformed message header '%s'.\n"), header);
+      exit (1);
+    }
+
+  *length_str = '\0';
+  payload = g_malloc (length + 1);
+
+  /* Large payloads might arrive in several reads */
+  while (total < length)
+    {
+      if (g_io_channel_read_chars (source, payload + total, length - total,
+                                   &bytes_read, &error) != G_IO_STATUS_NORMAL)
+        read_failed (error);
+
+      total += bytes_read;
+    }
+
+  payload[length] = '\0';
+
+  if (!(newline = memchr (payload, '\n', length)))
+    {
+      g_printerr (_("Error: malformed message header '%s'.\n"), header);
+      exit (1);
+    }
+
+  *newline = '\0';
+  *key = payload;
+  *data = newline + 1;
+
+  return header;
+}
+
+/* Builds the UI definition made of the chunks listed in @data, unless
+ * the current widget was built from the same ones.
+ */
+static void
+apply_update (GladePreviewerApp *app, gchar *toplevel, const gchar *data)
+{
+  GHashTable *chunks;
+  GObject *new_widget;
+  GString *ui;
+  GStrv hashes;
+  guint i;
+
+  hashes = g_strsplit (data, "\n", -1);
+
+  if (app->hashes && g_strv_equal ((const gchar * const *) hashes,
+                                   (const gchar * const *) app->hashes))
+    {
+      glade_previewer_present (app->preview);
+      g_strfreev (hashes);
+      return;
+    }
+
+  /* Only keep the chunks used by this update, Glade will not refer to
+   * any other chunk from now on.
+   */
+  chunks = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, g_free);
+  ui = g_string_new (NULL);
+
+  for (i = 0; hashes[i]; i++)
+    {
+      gchar *hash, *chunk;
+
+      if (!(chunk = g_hash_table_lookup (chunks, hashes[i])))
+        {
+          if (!g_hash_table_steal_extended (app->chunks, hashes[i],
+                                            (gpointer *) &hash, (gpointer *) &chunk))
+            {
+              g_printerr (_("Error: missing UI definition chunk %s.\n"), hashes[i]);
+              exit (1);
+            }
+
+          g_hash_table_insert (chunks, hash, chunk);
+        }
+
+      g_string_append (ui, chunk);
+    }
+
+  g_hash_table_destroy (app->chunks);
+  app->chunks = chunks;
+
+  g_strfreev (app->hashes);
+  app->hashes = hashes;
+
+  new_widget = get_toplevel_from_string (app, toplevel, ui->str, ui->len);
+  g_string_free (ui, TRUE);
+
+  if (new_widget)
+    {
+      glade_previewer_set_widget (app->preview, GTK_WIDGET (new_widget));
+      gtk_widget_show (GTK_WIDGET (new_widget));
+    }
+
+  glade_previewer_present (app->preview);
+}
+
+static gboolean
+on_frame_incoming (GIOChannel *source, GIOCondition condition, gpointer data)
+{
+  GladePreviewerApp *app = data;
+  gchar *kind, *key, *payload;
+
+  kind = read_frame (source, &key, &payload);
+
+  if (g_strcmp0 (kind, FRAME_QUIT) == 0)
+    {
+      g_free (kind);
+      g_free (key);
+      gtk_main_quit ();
+      return FALSE;
+    }
+
+  if (g_strcmp0 (kind, FRAME_CHUNK) == 0)
+    g_hash_table_insert (app->chunks, g_strdup (key), g_strdup (payload));
+  else if (g_strcmp0 (kind, FRAME_UPDATE) == 0)
+    apply_update (app, key, payload);
+  else
+    g_printerr (_("Ignoring unknown message '%s'.\n"), kind);
+
+  g_free (kind);
+  g_free (key);
+
+  return TRUE;
+}
+
 static GladePreviewerApp *
 glade_previewer_app_new (gchar *filename, gchar *toplevel)
 {
@@ -271,6 +435,7 @@ glade_previewer_app_new (gchar *filename, gchar *toplevel)
 
   app->file_name = g_strdup (filename);
   app->toplevel = g_strdup (toplevel);
+  app->chunks = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, g_free);
 
   return app;
 }
@@ -281,10 +446,13 @@ glade_previewer_free (GladePreviewerApp *app)
   g_object_unref (app->preview);
   g_free (app->file_name);
   g_free (app->toplevel);
+  g_hash_table_destroy (app->chunks);
+  g_strfreev (app->hashes);
   g_free (app);
 }
 
 static gboolean listen = FALSE;
+static gboolean framed = FALSE;
 static gboolean version = FALSE;
 static gboolean slideshow = FALSE;
 static gboolean template = FALSE;
@@ -302,6 +470,7 @@ static GOptionEntry option_entries[] =
     {"screenshot", 0, 0, G_OPTION_ARG_FILENAME, &screenshot_file_name, N_("File name to save a screenshot"), NULL},
     {"css", 0, 0, G_OPTION_ARG_FILENAME, &css_file_name, N_("CSS file to use"), NULL},
     {"listen", 'l', 0, G_OPTION_ARG_NONE, &listen, N_("Listen standard input"), NULL},
+    {"framed", 0, 0, G_OPTION_ARG_NONE, &framed, N_("Read length-prefixed messages from standard input"), NULL},
     {"slideshow", 0, 0, G_OPTION_ARG_NONE, &slideshow, N_("make a slideshow of every toplevel widget by adding them in a GtkStack"), NULL},
     {"print-handler", 0, 0, G_OPTION_ARG_NONE, &print_handler, N_("Print handlers signature on invocation"), NULL},
     {"version", 'v', 0, G_OPTION_ARG_NONE, &version, N_("Display previewer version"), NULL},
@@ -371,7 +540,13 @@ main (int argc, char **argv)
       GIOChannel *input = g_io_channel_unix_new (fileno (stdin));
 #endif
 
-      g_io_add_watch (input, G_IO_IN | G_IO_HUP, on_data_incoming, app);
+      if (framed)
+        {
+          g_io_channel_set_encoding (input, NULL, NULL);
+          g_io_add_watch (input, G_IO_IN | G_IO_HUP, on_frame_incoming, app);
+        }
+      else
+        g_io_add_watch (input, G_IO_IN | G_IO_HUP, on_data_incoming, app);
 
       gtk_main ();
     }
@@ -31,6 +31,9 @@
 #include "glade-widget.h"
 #include "glade-project-properties.h"
 #include "glade-property-def.h"
+#include "glade-preview.h"
+#include "glade-utils.h"
+#include "glade-editor.h"
 
 G_BEGIN_DECLS
 
@@ -44,6 +47,13 @@ GList *_glade_widget_peek_prop_refs (GladeWidget *widget);
 
 GladeCatalog *_glade_catalog_get_catalog (const gchar *name);
 GList        *_glade_catalog_tsort       (GList *catalogs);
+gboolean      _glade_catalog_load_deferred_class (const gchar  *name);
+gboolean      _glade_catalog_is_deferred         (GladeCatalog *catalog);
+
+/* glade-editor.c */
+
+GtkWidget *_glade_editor_get_page_editable (GladeEditor         *editor,
+                                            GladeEditorPageType  type);
 
 /* glade-project.c */
 
@@ -60,6 +70,26 @@ _glade_project_emit_change_signal_handler   (GladeWidget       *widget,
 void
 _glade_project_emit_activate_signal_handler (GladeWidget       *widget,
                                              const GladeSignal *signal);
+void
+_glade_project_prop_refs_changed            (GladeProject      *project,
+                                             GladeWidget       *widget);
+void
+_glade_project_write_cache_invalidate       (GladeProject      *project,
+                                             GladeWidget       *widget);
+gboolean
+_glade_project_widget_is_verified           (GladeProject      *project,
+                                             GladeWidget       *widget);
+GPtrArray *
+_glade_project_write_preview                (GladeProject      *project,
+                                             GladeWidget       *toplevel);
+gchar *
+_glade_project_verify_message               (GladeProject      *project,
+                                             GladeVerifyFlags   flags);
+
+/* glade-preview.c */
+void _glade_preview_update_chunks (GladePreview *preview,
+                                   GPtrArray    *chunks,
+                                   gboolean      present);
 
 /* glade-project-properties.c */
 void
@@ -84,9 +114,21 @@ _glade_project_properties_get_license_data (GladeProjectProperties *props,
 /* glade-property-def.c */
 void
 _glade_property_def_reset_version (GladePropertyDef *property_def);
+void
+_glade_property_def_set_ordinal   (GladePropertyDef *property_def,
+                                   gint              ordinal);
+gint
+_glade_property_def_get_ordinal   (GladePropertyDef *property_def);
 
 /* glade-utils.c */
 
+typedef gboolean (*GladeUIMessageFunc) (GladeUIMessageType  type,
+                                        const gchar        *message,
+                                        gpointer            user_data);
+
+void   _glade_util_set_ui_message_func (GladeUIMessageFunc func,
+                                        gpointer           user_data);
+
 gchar *_glade_util_compose_get_type_func (const gchar *name);
 
 void   _glade_util_dialog_set_hig (GtkDialog *dialog);
@@ -99,8 +141,31 @@ gchar *_glade_util_strreplace (gchar *str,
 gchar *_glade_util_file_get_relative_path (GFile *target,
                                            GFile *source);
 
+GdkPixbuf *_glade_util_pixbuf_cache_load      (const gchar *path);
+
+void       _glade_util_pixbuf_cache_get_stats (guint *hits,
+                                               guint *misses);
+
+/* glade-widget-adaptor.c */
+
+gboolean _glade_widget_adaptor_is_materialized (GladeWidgetAdaptor *adaptor);
+
 /* glade-xml-utils.c */
 
+GladeXmlNode *_glade_xml_node_get_last_child (GladeXmlNode *node);
+gchar        *_glade_xml_node_dump           (GladeXmlNode *node);
+gchar        *_glade_xml_doc_dump            (GladeXmlDoc  *doc,
+                                              gsize        *length);
+
+/* Streaming GladeXml reader */
+typedef struct _GladeXmlReader GladeXmlReader;
+
+GladeXmlReader *_glade_xml_reader_new        (const gchar    *full_path);
+void            _glade_xml_reader_free       (GladeXmlReader *reader);
+GladeXmlNode   *_glade_xml_reader_get_root   (GladeXmlReader *reader);
+GladeXmlNode   *_glade_xml_reader_next_child (GladeXmlReader *reader);
+gboolean        _glade_xml_reader_failed     (GladeXmlReader *reader);
+
 /* GladeXml Error handling */
 void    _glade_xml_error_reset_last       (void);
 gchar  *_glade_xml_error_get_last_message (void);
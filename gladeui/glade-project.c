@@ -75,6 +75,9 @@ static void     glade_project_set_readonly          (GladeProject       *project
                                                      gboolean            readonly);
 static void     glade_project_set_modified          (GladeProject       *project,
                                                      gboolean            modified);
+static void     glade_project_set_has_selection     (GladeProject       *project,
+                                                     gboolean            has_selection);
+static void     glade_project_queue_preview_update  (GladeProject       *project);
 
 static void     glade_project_model_iface_init      (GtkTreeModelIface  *iface);
 
@@ -93,6 +96,24 @@ struct _GladeProjectPrivate
   GList *tree;                  /* List of toplevel Objects in this projects */
   GList *objects;               /* List of all objects in this project */
   GtkTreeModel *model;          /* GtkTreeStore used as proxy model */
+  GHashTable *iters;            /* GtkTreeIter of every GladeWidget row in the proxy model,
+                                 * GtkTreeStore iters persist as long as the row exists
+                                 */
+  GHashTable *referenced;       /* Set of project widgets referenced by object properties,
+                                 * these are the nodes with edges in the dependency graph
+                                 */
+  GList *ordered_toplevels;     /* Cached toplevels save order, valid unless toplevels_dirty is set */
+  GHashTable *write_cache;      /* Serialized xml node of every unchanged toplevel since the last write */
+  GHashTable *verify_cache;     /* VerifyResult of every unchanged widget since it was last verified */
+  GPtrArray *object_refs;       /* ObjectRef entries read while loading, resolved once all objects exist */
+
+  guint bulk_depth;             /* Nesting of glade_project_begin_bulk_update() calls */
+  GPtrArray *bulk_added;        /* Widgets added in the bulk update, parents first, their rows
+                                 * and "add-widget" signals are deferred until it ends
+                                 */
+  GPtrArray *bulk_removed;      /* Widgets removed in the bulk update */
+  GHashTable *bulk_verify;      /* Widgets to verify once the bulk update ends */
+  GHashTable *bulk_reordered;   /* Widgets whose children rows are reordered once the bulk update ends */
 
   GList *selection;             /* We need to keep the selection in the project
                                  * because we have multiple projects and when the
@@ -100,13 +121,20 @@ struct _GladeProjectPrivate
                                  * not want to loose the selection. This is a list
                                  * of #GtkWidget items.
                                  */
+  GHashTable *selection_links;  /* Maps selected objects to their link in the selection list */
   guint selection_changed_id;
 
   GladeNameContext *widget_names; /* Context for uniqueness of names */
+  GHashTable *widgets_by_name;    /* Index of project widgets by name, the keys are
+                                   * owned by the table and the values are GladeWidgets
+                                   */
 
 
-  GList *undo_stack;            /* A stack with the last executed commands */
+  GQueue undo_stack;            /* A stack with the last executed commands */
   GList *prev_redo_item;        /* Points to the item previous to the redo items */
+  gsize undo_size;              /* Estimated memory held by the commands in undo_stack */
+  guint undo_max_commands;      /* Maximum length of undo_stack, 0 for no limit */
+  gsize undo_max_size;          /* Maximum undo_size in bytes, 0 for no limit */
 
   GList *first_modification;    /* we record the first modification, so that we
                                  * can set "modification" to FALSE when we
@@ -122,6 +150,10 @@ struct _GladeProjectPrivate
                                  */
 
   time_t mtime;                 /* last UTC modification time of file, or 0 if it could not be read */
+  guint saves;                  /* Number of times the project was saved, used to discard autosaves
+                                 * written by a worker thread while the project was being saved
+                                 */
+  GCancellable *autosave_cancellable; /* Cancelled when the project is disposed */
 
   GHashTable *target_versions_major;    /* target versions by catalog */
   GHashTable *target_versions_minor;    /* target versions by catalog */
@@ -140,6 +172,7 @@ struct _GladeProjectPrivate
 
   /* Store previews, so we can kill them on close */
   GHashTable *previews;
+  guint preview_update_id;      /* Source sending the latest changes to the previews */
 
   /* For the loading progress bars ("load-progress" signal) */
   gint progress_step;
@@ -157,7 +190,12 @@ struct _GladeProjectPrivate
                                   * requested
                                   */
   guint writing_preview : 1;     /* During serialization, if we are serializing for a preview */
+  guint toplevels_dirty : 1;     /* Whether the toplevels dependency graph changed since the last sort */
+  guint autosaving : 1;          /* Whether an autosave is being written in a worker thread */
+  guint autosave_pending : 1;    /* Whether another autosave was requested while autosaving */
+  guint undo_compaction : 1;     /* Whether to merge unifiable commands older than UNDO_COMPACTION_WINDOW */
   guint pointer_mode : 3;        /* The currently effective GladePointerMode */
+  guint bulk_selection_changed : 1; /* Whether the selection changed during the bulk update */
 };
 
 typedef struct 
@@ -166,6 +204,19 @@ typedef struct
   gint position;
 } CatalogInfo;
 
+typedef struct
+{
+  GladeProperty *property;
+  gchar *ids;
+} ObjectRef;
+
+typedef struct
+{
+  GladeVerifyFlags flags;       /* The flags the widget was verified with */
+  gchar *path_name;             /* The path name used in message */
+  gchar *message;               /* The problems found in the widget, or NULL */
+} VerifyResult;
+
 
 enum
 {
@@ -184,6 +235,8 @@ enum
   REMOVE_SIGNAL_HANDLER,
   CHANGE_SIGNAL_HANDLER,
   ACTIVATE_SIGNAL_HANDLER,
+  AUTOSAVED,
+  OBJECTS_CHANGED,
   LAST_SIGNAL
 };
 
@@ -212,6 +265,15 @@ static GladeIDAllocator *unsaved_number_allocator = NULL;
 #define GLADE_XML_COMMENT "Generated with "PACKAGE_NAME
 #define GLADE_PROJECT_LARGE_PROJECT 40
 
+/* Amount of recent commands which are never compacted */
+#define UNDO_COMPACTION_WINDOW 100
+
+/* Milliseconds between preview updates, about one frame */
+#define PREVIEW_UPDATE_INTERVAL 16
+
+/* Placeholder comment marking where toplevels go in a previewed document */
+#define PREVIEW_TOPLEVELS_MARK "toplevels"
+
 #define VALID_ITER(project, iter) \
   ((iter)!= NULL && G_IS_OBJECT ((iter)->user_data) && \
    ((GladeProject*)(project))->priv->stamp == (iter)->stamp)
@@ -255,6 +317,10 @@ glade_project_dispose (GObject *object)
   /* Emit close signal */
   g_signal_emit (object, glade_project_signals[CLOSE], 0);
 
+  /* Autosaves of a closed project are not written anymore */
+  g_cancellable_cancel (priv->autosave_cancellable);
+  priv->autosave_pending = FALSE;
+
   /* Disconnect from model */
 #define MODEL_DISCONNECT(func) g_signal_handlers_disconnect_by_func (priv->model, G_CALLBACK (func), project)
   MODEL_DISCONNECT (gtk_tree_model_row_changed);
@@ -268,10 +334,13 @@ glade_project_dispose (GObject *object)
 
   /* Clear selection */
   g_clear_pointer (&priv->selection, g_list_free);
+  g_hash_table_remove_all (priv->selection_links);
   g_clear_handle_id (&priv->selection_changed_id,  g_source_remove);
 
   /* Clear undo/redo stack */
-  g_clear_pointer (&priv->undo_stack, glade_project_list_unref);
+  glade_project_list_unref (priv->undo_stack.head);
+  g_queue_init (&priv->undo_stack);
+  priv->undo_size = 0;
 
   /* NOTE: prev_redo_item and first_modification always point to undo_stack
    * So we should never try to free it
@@ -280,6 +349,7 @@ glade_project_dispose (GObject *object)
   priv->first_modification = NULL;
 
   /* Destroy running previews */
+  g_clear_handle_id (&priv->preview_update_id, g_source_remove);
   if (priv->previews)
     {
       g_hash_table_destroy (priv->previews);
@@ -320,6 +390,22 @@ glade_project_dispose (GObject *object)
   G_OBJECT_CLASS (glade_project_parent_class)->dispose (object);
 }
 
+static void
+object_ref_free (ObjectRef *ref)
+{
+  g_object_unref (ref->property);
+  g_free (ref->ids);
+  g_slice_free (ObjectRef, ref);
+}
+
+static void
+verify_result_free (VerifyResult *result)
+{
+  g_free (result->path_name);
+  g_free (result->message);
+  g_slice_free (VerifyResult, result);
+}
+
 static void
 glade_project_finalize (GObject *object)
 {
@@ -341,6 +427,15 @@ glade_project_finalize (GObject *object)
   g_hash_table_destroy (priv->target_versions_minor);
 
   glade_name_context_destroy (priv->widget_names);
+  g_hash_table_destroy (priv->widgets_by_name);
+  g_hash_table_destroy (priv->iters);
+  g_hash_table_destroy (priv->referenced);
+  g_list_free (priv->ordered_toplevels);
+  g_hash_table_destroy (priv->write_cache);
+  g_hash_table_destroy (priv->verify_cache);
+  g_ptr_array_unref (priv->object_refs);
+  g_hash_table_destroy (priv->selection_links);
+  g_object_unref (priv->autosave_cancellable);
 
   G_OBJECT_CLASS (glade_project_parent_class)->finalize (object);
 }
@@ -444,7 +539,7 @@ glade_project_walk_forward (GladeProject *project)
   if (project->priv->prev_redo_item)
     project->priv->prev_redo_item = project->priv->prev_redo_item->next;
   else
-    project->priv->prev_redo_item = project->priv->undo_stack;
+    project->priv->prev_redo_item = project->priv->undo_stack.head;
 }
 
 static void
@@ -452,6 +547,9 @@ glade_project_undo_impl (GladeProject *project)
 {
   GladeCommand *cmd, *next_cmd;
 
+  /* Notify the changes of a whole group at once */
+  glade_project_begin_bulk_update (project);
+
   while ((cmd = glade_project_next_undo_item (project)) != NULL)
     {
       glade_command_undo (cmd);
@@ -466,6 +564,8 @@ glade_project_undo_impl (GladeProject *project)
            glade_command_group_id (next_cmd) != glade_command_group_id (cmd)))
         break;
     }
+
+  glade_project_end_bulk_update (project);
 }
 
 static void
@@ -473,6 +573,9 @@ glade_project_redo_impl (GladeProject *project)
 {
   GladeCommand *cmd, *next_cmd;
 
+  /* Notify the changes of a whole group at once */
+  glade_project_begin_bulk_update (project);
+
   while ((cmd = glade_project_next_redo_item (project)) != NULL)
     {
       glade_command_execute (cmd);
@@ -487,6 +590,8 @@ glade_project_redo_impl (GladeProject *project)
            glade_command_group_id (next_cmd) != glade_command_group_id (cmd)))
         break;
     }
+
+  glade_project_end_bulk_update (project);
 }
 
 static GladeCommand *
@@ -506,8 +611,8 @@ glade_project_next_redo_item_impl (GladeProject *project)
   GList *l;
 
   if ((l = project->priv->prev_redo_item) == NULL)
-    return project->priv->undo_stack ?
-        GLADE_COMMAND (project->priv->undo_stack->data) : NULL;
+    return project->priv->undo_stack.head ?
+        GLADE_COMMAND (project->priv->undo_stack.head->data) : NULL;
   else
     return l->next ? GLADE_COMMAND (l->next->data) : NULL;
 }
@@ -520,31 +625,113 @@ glade_project_free_undo_item (GladeProject *project, GList *item)
   if (item == project->priv->first_modification)
     project->priv->first_modification_is_na = TRUE;
 
+  project->priv->undo_size -= glade_command_get_size (item->data);
   g_object_unref (G_OBJECT (item->data));
 
   return g_list_next (item);
 }
 
+static gboolean
+glade_project_undo_exceeded (GladeProject *project)
+{
+  GladeProjectPrivate *priv = project->priv;
+
+  return
+    (priv->undo_max_commands && priv->undo_stack.length > priv->undo_max_commands) ||
+    (priv->undo_max_size && priv->undo_size > priv->undo_max_size);
+}
+
+/* Drops the oldest commands until the history fits in the configured
+ * limits, whole command groups are dropped at once and the last command
+ * that can be undone is always kept.
+ */
 static void
-glade_project_push_undo_impl (GladeProject *project, GladeCommand *cmd)
+glade_project_trim_undo (GladeProject *project)
 {
   GladeProjectPrivate *priv = project->priv;
-  GList *tmp_redo_item;
+  GList *link;
+  gint group_id, last_group_id;
 
-  /* We should now free all the "redo" items */
-  tmp_redo_item = g_list_next (priv->prev_redo_item);
-  while (tmp_redo_item)
-    tmp_redo_item = glade_project_free_undo_item (project, tmp_redo_item);
+  if (priv->prev_redo_item == NULL)
+    return;
 
-  if (priv->prev_redo_item)
+  last_group_id = glade_command_group_id (priv->prev_redo_item->data);
+
+  while (glade_project_undo_exceeded (project) &&
+         priv->undo_stack.head != priv->prev_redo_item)
     {
-      g_list_free (g_list_next (priv->prev_redo_item));
-      priv->prev_redo_item->next = NULL;
+      group_id = glade_command_group_id (priv->undo_stack.head->data);
+
+      if (group_id != 0 && group_id == last_group_id)
+        break;
+
+      do
+        {
+          link = g_queue_pop_head_link (&priv->undo_stack);
+
+          /* The unmodified state is now at the bottom of the stack,
+           * or can not be reached anymore at all.
+           */
+          if (priv->first_modification == link)
+            priv->first_modification = NULL;
+          else if (priv->first_modification == NULL)
+            priv->first_modification_is_na = TRUE;
+
+          priv->undo_size -= glade_command_get_size (link->data);
+          g_object_unref (link->data);
+          g_list_free_1 (link);
+        }
+      while (group_id != 0 &&
+             glade_command_group_id (priv->undo_stack.head->data) == group_id);
     }
-  else
+}
+
+/* Merges the command leaving the recent window into the previous one if
+ * they unify, so long runs of edits to the same property in the older
+ * history only take a single command.
+ */
+static void
+glade_project_compact_undo (GladeProject *project)
+{
+  GladeProjectPrivate *priv = project->priv;
+  GList *link, *prev;
+
+  if (priv->undo_stack.length <= UNDO_COMPACTION_WINDOW + 1)
+    return;
+
+  link = g_queue_peek_nth_link (&priv->undo_stack,
+                                priv->undo_stack.length - UNDO_COMPACTION_WINDOW - 1);
+  prev = link->prev;
+
+  /* Dont merge across the unmodified state */
+  if (prev == priv->first_modification ||
+      !glade_command_unifies (prev->data, link->data))
+    return;
+
+  priv->undo_size -= glade_command_get_size (prev->data);
+  glade_command_collapse (prev->data, link->data);
+  priv->undo_size += glade_command_get_size (prev->data);
+
+  if (priv->first_modification == link)
+    priv->first_modification = prev;
+
+  priv->undo_size -= glade_command_get_size (link->data);
+  g_object_unref (link->data);
+  g_queue_delete_link (&priv->undo_stack, link);
+}
+
+static void
+glade_project_push_undo_impl (GladeProject *project, GladeCommand *cmd)
+{
+  GladeProjectPrivate *priv = project->priv;
+  GList *tmp_redo_item;
+
+  /* We should now free all the "redo" items */
+  while (priv->undo_stack.tail && priv->undo_stack.tail != priv->prev_redo_item)
     {
-      g_list_free (priv->undo_stack);
-      priv->undo_stack = NULL;
+      tmp_redo_item = priv->undo_stack.tail;
+      glade_project_free_undo_item (project, tmp_redo_item);
+      g_queue_delete_link (&priv->undo_stack, tmp_redo_item);
     }
 
   /* Try to unify only if group depth is 0 and the project has not been recently saved */
@@ -556,7 +743,9 @@ glade_project_push_undo_impl (GladeProject *project, GladeCommand *cmd)
 
       if (glade_command_unifies (cmd1, cmd))
         {
+          priv->undo_size -= glade_command_get_size (cmd1);
           glade_command_collapse (cmd1, cmd);
+          priv->undo_size += glade_command_get_size (cmd1);
           g_object_unref (cmd);
 
           if (glade_command_unifies (cmd1, NULL))
@@ -564,8 +753,7 @@ glade_project_push_undo_impl (GladeProject *project, GladeCommand *cmd)
               tmp_redo_item = priv->prev_redo_item;
               glade_project_walk_back (project);
               glade_project_free_undo_item (project, tmp_redo_item);
-              priv->undo_stack =
-                g_list_delete_link (priv->undo_stack, tmp_redo_item);
+              g_queue_delete_link (&priv->undo_stack, tmp_redo_item);
 
               cmd1 = NULL;
             }
@@ -576,13 +764,22 @@ glade_project_push_undo_impl (GladeProject *project, GladeCommand *cmd)
         }
     }
 
-  /* and then push the new undo item */
-  priv->undo_stack = g_list_append (priv->undo_stack, cmd);
+  /* and then push the new undo item, there are no redo items left
+   * so it always goes at the tail.
+   */
+  g_queue_push_tail (&priv->undo_stack, cmd);
+  priv->prev_redo_item = priv->undo_stack.tail;
+  priv->undo_size += glade_command_get_size (cmd);
 
-  if (project->priv->prev_redo_item == NULL)
-    priv->prev_redo_item = priv->undo_stack;
-  else
-    priv->prev_redo_item = g_list_next (priv->prev_redo_item);
+  if (priv->undo_compaction && glade_command_get_group_depth () == 0)
+    glade_project_compact_undo (project);
+
+  glade_project_trim_undo (project);
+
+  GLADE_NOTE (COMMANDS,
+              g_print ("COMMANDS: undo history holds %u commands, "
+                       "%" G_GSIZE_FORMAT " bytes\n",
+                       priv->undo_stack.length, priv->undo_size));
 
   g_signal_emit (G_OBJECT (project),
                  glade_project_signals[CHANGED], 0, cmd, TRUE);
@@ -642,6 +839,8 @@ glade_project_changed_impl (GladeProject *project,
         glade_project_set_modified (project, FALSE);
       else
         glade_project_set_modified (project, TRUE);
+
+      glade_project_queue_preview_update (project);
     }
 }
 
@@ -684,6 +883,16 @@ glade_project_init (GladeProject *project)
 
   priv->path = NULL;
   priv->model = GTK_TREE_MODEL (gtk_tree_store_new (1, G_TYPE_OBJECT));
+  priv->iters = g_hash_table_new_full (NULL, NULL, NULL,
+                                       (GDestroyNotify) gtk_tree_iter_free);
+  priv->referenced = g_hash_table_new (NULL, NULL);
+  priv->toplevels_dirty = TRUE;
+  priv->write_cache = g_hash_table_new_full (NULL, NULL, NULL,
+                                             (GDestroyNotify) glade_xml_node_delete);
+  priv->verify_cache = g_hash_table_new_full (NULL, NULL, NULL,
+                                              (GDestroyNotify) verify_result_free);
+  priv->autosave_cancellable = g_cancellable_new ();
+  priv->object_refs = g_ptr_array_new_with_free_func ((GDestroyNotify) object_ref_free);
 
   g_signal_connect_swapped (priv->model, "row-changed",
                             G_CALLBACK (gtk_tree_model_row_changed),
@@ -704,8 +913,9 @@ glade_project_init (GladeProject *project)
   priv->readonly = FALSE;
   priv->tree = NULL;
   priv->selection = NULL;
+  priv->selection_links = g_hash_table_new (NULL, NULL);
   priv->has_selection = FALSE;
-  priv->undo_stack = NULL;
+  g_queue_init (&priv->undo_stack);
   priv->prev_redo_item = NULL;
   priv->first_modification = NULL;
   priv->first_modification_is_na = FALSE;
@@ -717,6 +927,8 @@ glade_project_init (GladeProject *project)
                                           glade_project_destroy_preview);
 
   priv->widget_names = glade_name_context_new ();
+  priv->widgets_by_name = g_hash_table_new_full (g_str_hash, g_str_equal,
+                                                 g_free, NULL);
 
   priv->unsaved_number =
       glade_id_allocator_allocate (get_unsaved_number_allocator ());
@@ -1009,6 +1221,50 @@ glade_project_class_init (GladeProjectClass *klass)
                     GLADE_TYPE_WIDGET,
                     GLADE_TYPE_SIGNAL);
 
+  /**
+   * GladeProject::autosaved:
+   * @gladeproject: the #GladeProject which received the signal.
+   * @error: (nullable): a #GError if the autosave failed or %NULL
+   *
+   * Emitted when an autosave queued with glade_project_queue_autosave()
+   * has been written, or failed to be written.
+   */
+  glade_project_signals[AUTOSAVED] =
+      g_signal_new ("autosaved",
+                    G_TYPE_FROM_CLASS (object_class),
+                    G_SIGNAL_RUN_LAST,
+                    0,
+                    NULL, NULL,
+                    g_cclosure_marshal_VOID__BOXED,
+                    G_TYPE_NONE,
+                    1,
+                    G_TYPE_ERROR | G_SIGNAL_TYPE_STATIC_SCOPE);
+
+  /**
+   * GladeProject::objects-changed:
+   * @gladeproject: the #GladeProject which received the signal.
+   * @added: (element-type GladeWidget): the widgets added to @gladeproject
+   * @removed: (element-type GladeWidget): the widgets removed from @gladeproject
+   *
+   * Emitted once at the end of a bulk update, after the "add-widget" signals
+   * of its widgets, see glade_project_begin_bulk_update(). Adding or removing
+   * a single object hierarchy is a bulk update of its own.
+   *
+   * A widget added and removed again in the same bulk update is in neither
+   * list.
+   */
+  glade_project_signals[OBJECTS_CHANGED] =
+      g_signal_new ("objects-changed",
+                    G_TYPE_FROM_CLASS (object_class),
+                    G_SIGNAL_RUN_LAST,
+                    0,
+                    NULL, NULL,
+                    _glade_marshal_VOID__BOXED_BOXED,
+                    G_TYPE_NONE,
+                    2,
+                    G_TYPE_PTR_ARRAY | G_SIGNAL_TYPE_STATIC_SCOPE,
+                    G_TYPE_PTR_ARRAY | G_SIGNAL_TYPE_STATIC_SCOPE);
+
   glade_project_props[PROP_MODIFIED] =
     g_param_spec_boolean ("modified",
                           "Modified",
@@ -1350,49 +1606,95 @@ glade_project_new (void)
   return project;
 }
 
-/* Called when finishing loading a glade file to resolve object type properties
+/* Sets the property of @ref to the objects named in its id list,
+ * the ids which are not found in the project are appended to @unresolved.
  */
 static void
-glade_project_fix_object_props (GladeProject *project)
+glade_project_resolve_object_ref (GladeProject *project,
+                                  ObjectRef    *ref,
+                                  GString      *unresolved)
 {
-  GList *l, *ll, *objects;
+  GladePropertyDef *def = glade_property_get_def (ref->property);
+  GladeWidget *widget = glade_property_get_widget (ref->property);
   GValue *value;
-  GladeWidget *gwidget;
-  GladeProperty *property;
-  gchar *txt;
+  gchar **ids;
+  guint i;
 
-  objects = g_list_copy (project->priv->objects);
-  for (l = objects; l; l = l->next)
+  ids = g_strsplit (ref->ids, GLADE_PROPERTY_DEF_OBJECT_DELIMITER, 0);
+  for (i = 0; ids[i]; i++)
     {
-      gwidget = glade_widget_get_from_gobject (l->data);
+      if (*ids[i] && !glade_project_get_widget_by_name (project, ids[i]))
+        g_string_append_printf (unresolved, "\n  %s:%s \"%s\"",
+                                glade_widget_get_name (widget),
+                                glade_property_def_id (def), ids[i]);
+    }
+  g_strfreev (ids);
 
-      for (ll = glade_widget_get_properties (gwidget); ll; ll = ll->next)
-        {
-          GladePropertyDef *def;
+  /* Parse the object list and set the property to it
+   * (this magically works for both objects & object lists)
+   */
+  value = glade_property_def_make_gvalue_from_string (def, ref->ids, project);
 
-          property = GLADE_PROPERTY (ll->data);
-          def      = glade_property_get_def (property);
+  glade_property_set_value (ref->property, value);
 
-          if (glade_property_def_is_object (def) &&
-              (txt = g_object_get_data (G_OBJECT (property),
-                                        "glade-loaded-object")) != NULL)
-            {
-              /* Parse the object list and set the property to it
-               * (this magically works for both objects & object lists)
-               */
-              value = glade_property_def_make_gvalue_from_string (def, txt, project);
+  g_value_unset (value);
+  g_free (value);
+}
 
-              glade_property_set_value (property, value);
+/* Plugins used to leave the ids read for object properties as
+ * "glade-loaded-object" data on the property, queue those as well. Any
+ * read hook might still do that, so every widget is looked at, which is
+ * cheap next to reading them.
+ */
+static void
+glade_project_queue_loaded_objects (GladeProject *project)
+{
+  GList *l, *ll;
 
-              g_value_unset (value);
-              g_free (value);
+  for (l = project->priv->objects; l; l = l->next)
+    {
+      GladeWidget *gwidget = glade_widget_get_from_gobject (l->data);
+
+      for (ll = glade_widget_get_properties (gwidget); ll; ll = ll->next)
+        {
+          GladeProperty *property = ll->data;
+          const gchar *ids;
 
-              g_object_set_data (G_OBJECT (property),
-                                 "glade-loaded-object", NULL);
+          if (glade_property_def_is_object (glade_property_get_def (property)) &&
+              (ids = g_object_get_data (G_OBJECT (property), "glade-loaded-object")) != NULL)
+            {
+              glade_project_queue_object_reference (project, property, ids);
+              g_object_set_data (G_OBJECT (property), "glade-loaded-object", NULL);
             }
         }
     }
-  g_list_free (objects);
+}
+
+/* Called when finishing loading a glade file to resolve the object type
+ * properties queued with glade_project_queue_object_reference()
+ */
+static void
+glade_project_fix_object_props (GladeProject *project)
+{
+  GladeProjectPrivate *priv = project->priv;
+  GString *unresolved = g_string_new (NULL);
+  guint i;
+
+  for (i = 0; i < priv->object_refs->len; i++)
+    glade_project_resolve_object_ref (project,
+                                      g_ptr_array_index (priv->object_refs, i),
+                                      unresolved);
+
+  if (unresolved->len)
+    {
+      gchar *name = glade_project_get_name (project);
+
+      g_message ("Unresolved object references in %s:%s", name, unresolved->str);
+      g_free (name);
+    }
+
+  g_ptr_array_set_size (priv->object_refs, 0);
+  g_string_free (unresolved, TRUE);
 }
 
 static void
@@ -1619,6 +1921,7 @@ glade_project_set_resource_path (GladeProject *project, const gchar *path)
       project->priv->resource_path = g_strdup (path);
 
       update_project_for_resource_path (project);
+      _glade_project_write_cache_invalidate (project, NULL);
 
       g_object_notify_by_pspec (G_OBJECT (project), glade_project_props[PROP_RESOURCE_PATH]);
     }
@@ -1876,23 +2179,78 @@ glade_project_introspect_gtk_version (GladeProject *project)
 }
 
 
+static inline gboolean
+xml_tag_at (const gchar *p, const gchar *end, const gchar *tag, gsize len)
+{
+  return (end - p) > len + 1 &&
+    strncmp (p + 1, tag, len) == 0 &&
+    (g_ascii_isspace (p[len + 1]) || p[len + 1] == '>' || p[len + 1] == '/');
+}
+
+/* Counts object and template start tags in the raw file contents, this
+ * is much cheaper than parsing it and good enough for progress reports
+ * even though tags inside comments and CDATA are counted too.
+ *
+ * @late_requires is set if a requires tag follows the first object.
+ */
 static gint
-glade_project_count_xml_objects (GladeProject *project,
-                                 GladeXmlNode *root,
-                                 gint          count)
+glade_project_count_xml_objects (const gchar *path, gboolean *late_requires)
+{
+  GMappedFile *file;
+  const gchar *contents, *end, *p;
+  gsize length;
+  gint count = 0;
+
+  *late_requires = FALSE;
+
+  if (!(file = g_mapped_file_new (path, FALSE, NULL)))
+    return 0;
+
+  contents = g_mapped_file_get_contents (file);
+  length = g_mapped_file_get_length (file);
+  end = contents + length;
+
+  for (p = length ? memchr (contents, '<', length) : NULL; p;
+       p = memchr (p + 1, '<', end - p - 1))
+    {
+      if (xml_tag_at (p, end, GLADE_XML_TAG_WIDGET, strlen (GLADE_XML_TAG_WIDGET)) ||
+          xml_tag_at (p, end, GLADE_XML_TAG_TEMPLATE, strlen (GLADE_XML_TAG_TEMPLATE)))
+        count++;
+      else if (count > 0 &&
+               xml_tag_at (p, end, GLADE_XML_TAG_REQUIRES, strlen (GLADE_XML_TAG_REQUIRES)))
+        *late_requires = TRUE;
+    }
+
+  g_mapped_file_unref (file);
+
+  return count;
+}
+
+/* Appends a copy of the requires tags following the first object of @path
+ * to @root. GtkBuilder accepts them anywhere in the interface, they have to
+ * be read before any object since the target versions are used as soon as
+ * widgets are read.
+ */
+static void
+glade_project_copy_late_requires (GladeXmlNode *root, const gchar *path)
 {
+  GladeXmlReader *reader;
   GladeXmlNode *node;
+  gboolean objects = FALSE;
+
+  if (!(reader = _glade_xml_reader_new (path)))
+    return;
 
-  for (node = glade_xml_node_get_children (root);
-       node; node = glade_xml_node_next (node))
+  while ((node = _glade_xml_reader_next_child (reader)))
     {
       if (glade_xml_node_verify_silent (node, GLADE_XML_TAG_WIDGET) ||
           glade_xml_node_verify_silent (node, GLADE_XML_TAG_TEMPLATE))
-        count = glade_project_count_xml_objects (project, node, ++count);
-      else if (glade_xml_node_verify_silent (node, GLADE_XML_TAG_CHILD))
-        count = glade_project_count_xml_objects (project, node, count);
+        objects = TRUE;
+      else if (objects && glade_xml_node_verify_silent (node, GLADE_XML_TAG_REQUIRES))
+        glade_xml_node_append_child (root, glade_xml_node_copy (node));
     }
-  return count;
+
+  _glade_xml_reader_free (reader);
 }
 
 void
@@ -1922,6 +2280,44 @@ glade_project_push_progress (GladeProject *project)
                  project->priv->progress_full, project->priv->progress_step);
 }
 
+/**
+ * glade_project_queue_object_reference:
+ * @project: a #GladeProject
+ * @property: an object or object list #GladeProperty of a widget in @project
+ * @ids: the names of the referenced objects, separated by
+ *       %GLADE_PROPERTY_DEF_OBJECT_DELIMITER
+ *
+ * Sets @property to the objects named by @ids once @project finishes
+ * loading, when all the objects it references exist. Ids which do not
+ * name any object in @project are reported at that point.
+ *
+ * If @project is not being loaded, @property is set right away.
+ *
+ * This replaces leaving @ids as "glade-loaded-object" data on @property,
+ * which is still read once loading finishes for the widgets of catalogs
+ * other than the ones shipped with Glade.
+ */
+void
+glade_project_queue_object_reference (GladeProject  *project,
+                                      GladeProperty *property,
+                                      const gchar   *ids)
+{
+  ObjectRef *ref;
+
+  g_return_if_fail (GLADE_IS_PROJECT (project));
+  g_return_if_fail (GLADE_IS_PROPERTY (property));
+  g_return_if_fail (ids != NULL);
+
+  ref = g_slice_new (ObjectRef);
+  ref->property = g_object_ref (property);
+  ref->ids = g_strdup (ids);
+
+  g_ptr_array_add (project->priv->object_refs, ref);
+
+  if (!project->priv->loading)
+    glade_project_fix_object_props (project);
+}
+
 
 /* translators: refers to project name '%s' that targets gtk version '%d.%d' */
 #define PROJECT_TARGET_DIALOG_TITLE_FMT _("%s targets Gtk+ %d.%d")
@@ -1933,10 +2329,9 @@ glade_project_check_target_version (GladeProject *project)
   GHashTable *unknown_classes;
   gint unknown_objects;
   gint major, minor;
-  GtkWidget *dialog;
   GString *text = NULL;
   GList *l;
-  gchar *project_name;
+  gchar *project_name, *title, *message;
 
   glade_project_get_target_version (project, "gtk+", &major, &minor);
     
@@ -1983,22 +2378,19 @@ glade_project_check_target_version (GladeProject *project)
       g_string_free (missing_types, TRUE);
     }
 
+  /* Go through glade_util_ui_message() so programs without a user
+   * get the message too.
+   */
   project_name = glade_project_get_name (project);
-  dialog = gtk_message_dialog_new (GTK_WINDOW (glade_app_get_window ()),
-                                   GTK_DIALOG_DESTROY_WITH_PARENT,
-                                   GTK_MESSAGE_WARNING, GTK_BUTTONS_OK,
-                                   PROJECT_TARGET_DIALOG_TITLE_FMT,
-                                   project_name,
-                                   major, minor);
+  title = g_strdup_printf (PROJECT_TARGET_DIALOG_TITLE_FMT, project_name, major, minor);
+  message = g_markup_printf_escaped ("<b>%s</b>\n\n%s%s", title,
+                                     _("But this version of Glade is for GTK+ 3 only.\n"
+                                       "Make sure you can run this project with Glade 3.8 with no deprecated widgets first.\n"),
+                                     (text) ? text->str : "");
+  glade_util_ui_message (glade_app_get_window (), GLADE_UI_WARN, NULL, "%s", message);
   g_free (project_name);
-
-  gtk_message_dialog_format_secondary_text (GTK_MESSAGE_DIALOG (dialog),
-                                            _("But this version of Glade is for GTK+ 3 only.\n"
-                                              "Make sure you can run this project with Glade 3.8 with no deprecated widgets first.\n"
-                                              "%s"), (text) ? text->str : "");
-
-  gtk_dialog_run (GTK_DIALOG (dialog));
-  gtk_widget_destroy (dialog);
+  g_free (message);
+  g_free (title);
 
   glade_project_set_target_version (project, "gtk+", 3, 0);
 
@@ -2029,12 +2421,13 @@ static gboolean
 glade_project_load_internal (GladeProject *project)
 {
   GladeProjectPrivate *priv = project->priv;
-  GladeXmlContext *context;
-  GladeXmlDoc *doc;
+  GladeXmlReader *reader;
   GladeXmlNode *root;
   GladeXmlNode *node;
   GladeWidget *widget;
   gboolean has_gtk_dep = FALSE;
+  gboolean late_requires;
+  gboolean parse_failed = FALSE;
   gchar *domain;
   gint count;
   gchar *autosave_path;
@@ -2066,15 +2459,17 @@ glade_project_load_internal (GladeProject *project)
 
   g_free (autosave_path);
 
-  priv->selection = NULL;
+  glade_project_selection_clear (project, FALSE);
   priv->objects = NULL;
   priv->loading = TRUE;
 
   _glade_xml_error_reset_last ();
 
-  /* get the context & root node of the catalog file */
-  if (!(context =
-        glade_xml_context_new_from_path (load_path ? load_path : priv->path, NULL, NULL)))
+  /* Open the file and read up to its root node, objects are read
+   * one toplevel at a time afterwards so the whole document is never
+   * kept in memory.
+   */
+  if (!(reader = _glade_xml_reader_new (load_path ? load_path : priv->path)))
     {
       gchar *message = _glade_xml_error_get_last_message ();
 
@@ -2097,8 +2492,7 @@ glade_project_load_internal (GladeProject *project)
 
   priv->mtime = mtime;
 
-  doc = glade_xml_context_get_doc (context);
-  root = glade_xml_doc_get_root (doc);
+  root = _glade_xml_reader_get_root (reader);
 
   if (!glade_xml_node_verify_silent (root, GLADE_XML_TAG_PROJECT))
     {
@@ -2110,7 +2504,7 @@ glade_project_load_internal (GladeProject *project)
         glade_util_ui_message (glade_app_get_window (), GLADE_UI_ERROR, NULL,
                                "Couldn't recognize GtkBuilder xml.\nskipping %s",
                                load_path ? load_path : priv->path);
-      glade_xml_context_free (context);
+      _glade_xml_reader_free (reader);
       g_free (load_path);
       priv->loading = FALSE;
       return FALSE;
@@ -2127,6 +2521,23 @@ glade_project_load_internal (GladeProject *project)
 
   glade_project_read_comments (project, root);
 
+  /* Collect the requires tags and comments preceding the first object */
+  while ((node = _glade_xml_reader_next_child (reader)) &&
+         !(glade_xml_node_verify_silent (node, GLADE_XML_TAG_WIDGET) ||
+           glade_xml_node_verify_silent (node, GLADE_XML_TAG_TEMPLATE)))
+    glade_xml_node_append_child (root, glade_xml_node_copy (node));
+
+  /* Launch a dialog if it's going to take enough time to be
+   * worth showing at all */
+  count = glade_project_count_xml_objects (load_path ? load_path : priv->path,
+                                           &late_requires);
+  priv->progress_full = count;
+  priv->progress_step = 0;
+
+  /* Glade writes requires tags first, others need another pass */
+  if (late_requires)
+    glade_project_copy_late_requires (root, load_path ? load_path : priv->path);
+
   /* Read requires, and do not abort load if there are missing catalog since
    * GladeObjectStub is created to keep the original xml for unknown object classes
    */
@@ -2135,16 +2546,11 @@ glade_project_load_internal (GladeProject *project)
   /* Read the rest of properties saved as comments */
   glade_project_read_comment_properties (project, root);
 
-  /* Launch a dialog if it's going to take enough time to be
-   * worth showing at all */
-  count = glade_project_count_xml_objects (project, root, 0);
-  priv->progress_full = count;
-  priv->progress_step = 0;
+  glade_project_begin_bulk_update (project);
 
-  for (node = glade_xml_node_get_children (root);
-       node; node = glade_xml_node_next (node))
+  for (; node; node = _glade_xml_reader_next_child (reader))
     {
-      /* Skip "requires" tags */
+      /* Skip "requires" tags and comments, already read */
       if (!(glade_xml_node_verify_silent (node, GLADE_XML_TAG_WIDGET) ||
             glade_xml_node_verify_silent (node, GLADE_XML_TAG_TEMPLATE)))
         continue;
@@ -2156,11 +2562,29 @@ glade_project_load_internal (GladeProject *project)
         break;
     }
 
-  /* Finished with the xml context */
-  glade_xml_context_free (context);
+  glade_project_end_bulk_update (project);
+
+  if (!priv->load_cancel && _glade_xml_reader_failed (reader))
+    {
+      gchar *message = _glade_xml_error_get_last_message ();
+
+      if (message)
+        {
+          gchar *escaped = g_markup_escape_text (message, -1);
+          glade_util_ui_message (glade_app_get_window (), GLADE_UI_ERROR, NULL, "%s", escaped);
+          g_free (escaped);
+          g_free (message);
+        }
+
+      parse_failed = TRUE;
+    }
+
+  /* Finished with the xml reader */
+  _glade_xml_reader_free (reader);
 
-  if (priv->load_cancel)
+  if (priv->load_cancel || parse_failed)
     {
+      g_ptr_array_set_size (priv->object_refs, 0);
       priv->loading = FALSE;
       g_free (load_path);
       return FALSE;
@@ -2172,9 +2596,10 @@ glade_project_load_internal (GladeProject *project)
   if (glade_util_file_is_writeable (priv->path) == FALSE)
     glade_project_set_readonly (project, TRUE);
 
-  /* Now we have to loop over all the object properties
-   * and fix'em all ('cause they probably weren't found)
+  /* Now resolve the object properties read before the objects
+   * they reference were created.
    */
+  glade_project_queue_loaded_objects (project);
   glade_project_fix_object_props (project);
 
   glade_project_fix_template (project);
@@ -2434,12 +2859,17 @@ static GList *
 glade_project_get_graph_deps (GladeProject *project)
 {
   GladeProjectPrivate *priv = project->priv;
-  GList *l, *edges = NULL;
-  
-  /* Create edges of the directed graph */
-  for (l = priv->objects; l; l = g_list_next (l))
+  GHashTableIter iter;
+  gpointer key;
+  GList *edges = NULL;
+
+  /* Create edges of the directed graph, only referenced widgets have edges.
+   * The iteration order does not matter since edges are sorted by name later.
+   */
+  g_hash_table_iter_init (&iter, priv->referenced);
+  while (g_hash_table_iter_next (&iter, &key, NULL))
     {
-      GladeWidget *predecessor = glade_widget_get_from_gobject (l->data);
+      GladeWidget *predecessor = key;
       GladeWidget *predecessor_top;
       GList *ll;
 
@@ -2471,6 +2901,7 @@ glade_project_get_nodes_from_edges (GladeProject *project, GList *edges)
 {
   GList *l, *hard_edges = NULL;
   GList *cycles = NULL;
+  GHashTable *seen = g_hash_table_new (NULL, NULL);
 
   /* Collect widgets with circular dependencies */
   for (l = edges; l; l = g_list_next (l))
@@ -2485,7 +2916,7 @@ glade_project_get_nodes_from_edges (GladeProject *project, GList *edges)
       if (glade_widget_get_parent (edge->successor))
         continue;
 
-      if (!g_list_find (cycles, edge->successor))
+      if (g_hash_table_add (seen, edge->successor))
         cycles = g_list_prepend (cycles, edge->successor);
     }
 
@@ -2493,7 +2924,10 @@ glade_project_get_nodes_from_edges (GladeProject *project, GList *edges)
   cycles = g_list_sort (cycles, glade_widgets_name_cmp);
 
   if (!hard_edges)
-    return cycles;
+    {
+      g_hash_table_destroy (seen);
+      return cycles;
+    }
 
   /* Sort them by hard deps */
   cycles = _glade_tsort (&cycles, &hard_edges);
@@ -2502,6 +2936,8 @@ glade_project_get_nodes_from_edges (GladeProject *project, GList *edges)
     {
       GList *l, *hard_cycles = NULL;
 
+      g_hash_table_remove_all (seen);
+
       /* Collect widgets with hard circular dependencies */
       for (l = hard_edges; l; l = g_list_next (l))
         {
@@ -2511,7 +2947,7 @@ glade_project_get_nodes_from_edges (GladeProject *project, GList *edges)
           if (glade_widget_get_parent (edge->successor))
             continue;
 
-          if (!g_list_find (hard_cycles, edge->successor))
+          if (g_hash_table_add (seen, edge->successor))
             hard_cycles = g_list_prepend (hard_cycles, edge->successor);
         }
 
@@ -2525,6 +2961,8 @@ glade_project_get_nodes_from_edges (GladeProject *project, GList *edges)
       _node_edge_list_free (hard_edges);
     }
 
+  g_hash_table_destroy (seen);
+
   return cycles;
 }
 
@@ -2562,6 +3000,12 @@ G_GNUC_END_IGNORE_DEPRECATIONS
   return edges;
 }
 
+static void
+glade_project_invalidate_toplevels_order (GladeProject *project)
+{
+  project->priv->toplevels_dirty = TRUE;
+}
+
 static GList *
 glade_project_get_ordered_toplevels (GladeProject *project)
 {
@@ -2569,6 +3013,10 @@ glade_project_get_ordered_toplevels (GladeProject *project)
   GList *l, *sorted_tree, *tree = NULL;
   GList *edges;
 
+  /* Only sort again if the dependency graph changed */
+  if (!priv->toplevels_dirty)
+    return g_list_copy (priv->ordered_toplevels);
+
   /* Create list of toplevels GladeWidgets */
   for (l = priv->tree; l; l = g_list_next (l))
     tree = g_list_prepend (tree, glade_widget_get_from_gobject (l->data));
@@ -2601,6 +3049,10 @@ glade_project_get_ordered_toplevels (GladeProject *project)
       _node_edge_list_free (edges);
     }
 
+  g_list_free (priv->ordered_toplevels);
+  priv->ordered_toplevels = g_list_copy (sorted_tree);
+  priv->toplevels_dirty = FALSE;
+
   /* No need to free tree as tsort will consume the list */
   return sorted_tree;
 }
@@ -2635,15 +3087,16 @@ glade_project_write_comments (GladeProject *project,
     }
 }
 
+/* Creates a document with the project metadata, the toplevels are
+ * then appended to the returned @root by the caller.
+ */
 static GladeXmlContext *
-glade_project_write (GladeProject *project)
+glade_project_write_document (GladeProject *project, GladeXmlNode **root_ret)
 {
   GladeProjectPrivate *priv = project->priv;
   GladeXmlContext *context;
   GladeXmlDoc *doc;
   GladeXmlNode *root;
-  GList *list;
-  GList *toplevels;
 
   doc = glade_xml_doc_new ();
   context = glade_xml_context_new (doc, NULL);
@@ -2663,22 +3116,52 @@ glade_project_write (GladeProject *project)
 
   glade_project_write_license_data (project, context, root);
 
+  *root_ret = root;
+
+  return context;
+}
+
+static GladeXmlContext *
+glade_project_write (GladeProject *project)
+{
+  GladeProjectPrivate *priv = project->priv;
+  GladeXmlContext *context;
+  GladeXmlNode *root;
+  GList *list;
+  GList *toplevels;
+
+  context = glade_project_write_document (project, &root);
+
   /* Get sorted toplevels */
   toplevels = glade_project_get_ordered_toplevels (project);
 
   for (list = toplevels; list; list = g_list_next (list))
     {
       GladeWidget *widget = list->data;
+      GladeXmlNode *cached;
+
+      if (glade_widget_get_parent (widget))
+        {
+          g_warning ("Tried to save a non toplevel object '%s' at xml root",
+                     glade_widget_get_name (widget));
+          continue;
+        }
+
+      /* Splice in a copy of the toplevel if it did not change since last write */
+      if ((cached = g_hash_table_lookup (priv->write_cache, widget)))
+        {
+          glade_xml_node_append_child (root, glade_xml_node_copy (cached));
+          continue;
+        }
 
       /* 
        * Append toplevel widgets. Each widget then takes
        * care of appending its children.
        */
-      if (!glade_widget_get_parent (widget))
-        glade_widget_write (widget, context, root);
-      else
-        g_warning ("Tried to save a non toplevel object '%s' at xml root",
-                   glade_widget_get_name (widget));
+      glade_widget_write (widget, context, root);
+
+      g_hash_table_insert (priv->write_cache, widget,
+                           glade_xml_node_copy (_glade_xml_node_get_last_child (root)));
     }
 
   g_list_free (toplevels);
@@ -2771,10 +3254,146 @@ glade_project_autosave (GladeProject *project, GError **error)
   return ret > 0;
 }
 
-static inline void
-update_project_resource_path (GladeProject *project, gchar *path)
+typedef struct
 {
-  GFile *new_resource_path;
+  GWeakRef project;             /* The task does not keep the project alive */
+  GladeXmlContext *context;     /* The project snapshot, only used by the worker thread */
+  gchar *path;                  /* The autosave file path */
+  guint saves;                  /* The project saves count when the snapshot was taken */
+} AutosaveData;
+
+static void
+autosave_data_free (AutosaveData *data)
+{
+  g_weak_ref_clear (&data->project);
+  glade_xml_context_free (data->context);
+  g_free (data->path);
+  g_slice_free (AutosaveData, data);
+}
+
+static void
+glade_project_autosave_thread (GTask        *task,
+                               gpointer      source_object,
+                               gpointer      task_data,
+                               GCancellable *cancellable)
+{
+  AutosaveData *data = task_data;
+  GError *error = NULL;
+  gchar *text;
+  gsize length;
+
+  text = _glade_xml_doc_dump (glade_xml_context_get_doc (data->context), &length);
+
+  /* The project might have been closed meanwhile */
+  if (g_task_return_error_if_cancelled (task))
+    {
+      g_free (text);
+      return;
+    }
+
+  /* g_file_set_contents() writes a temporary file and renames it over
+   * the autosave, so a crash in the middle never leaves a truncated file
+   */
+  if (g_file_set_contents (data->path, text, length, &error))
+    g_task_return_boolean (task, TRUE);
+  else
+    g_task_return_error (task, error);
+
+  g_free (text);
+}
+
+static void
+glade_project_autosave_finish (GObject      *source_object,
+                               GAsyncResult *result,
+                               gpointer      user_data)
+{
+  AutosaveData *data = g_task_get_task_data (G_TASK (result));
+  GladeProject *project = g_weak_ref_get (&data->project);
+  GError *error = NULL;
+
+  /* Nobody is left to tell, the write was cancelled unless it was done */
+  if (project == NULL)
+    return;
+
+  project->priv->autosaving = FALSE;
+
+  /* The project was saved while writing, the autosave is already stale */
+  if (g_task_propagate_boolean (G_TASK (result), &error) &&
+      data->saves != project->priv->saves)
+    g_unlink (data->path);
+
+  /* A disposed project is still referenced somewhere, but closed */
+  if (g_error_matches (error, G_IO_ERROR, G_IO_ERROR_CANCELLED))
+    {
+      g_error_free (error);
+      g_object_unref (project);
+      return;
+    }
+
+  g_signal_emit (project, glade_project_signals[AUTOSAVED], 0, error);
+  g_clear_error (&error);
+
+  if (project->priv->autosave_pending)
+    {
+      project->priv->autosave_pending = FALSE;
+      glade_project_queue_autosave (project);
+    }
+
+  g_object_unref (project);
+}
+
+/**
+ * glade_project_queue_autosave:
+ * @project: a #GladeProject
+ *
+ * Saves an autosave snapshot of @project to it's currently set path
+ * without blocking, the project is serialized right away and the
+ * snapshot is written to disk in a worker thread.
+ *
+ * If an autosave is already being written, a new snapshot will be taken
+ * once it finishes, no matter how many times this is called meanwhile.
+ *
+ * The #GladeProject::autosaved signal is emitted once the snapshot is
+ * written. If the project was never saved, nothing is done.
+ */
+void
+glade_project_queue_autosave (GladeProject *project)
+{
+  AutosaveData *data;
+  GTask *task;
+
+  g_return_if_fail (GLADE_IS_PROJECT (project));
+
+  if (project->priv->path == NULL)
+    return;
+
+  if (project->priv->autosaving)
+    {
+      project->priv->autosave_pending = TRUE;
+      return;
+    }
+
+  data = g_slice_new (AutosaveData);
+  g_weak_ref_init (&data->project, project);
+  data->context = glade_project_write (project);
+  data->path = glade_project_autosave_name (project->priv->path);
+  data->saves = project->priv->saves;
+
+  project->priv->autosaving = TRUE;
+
+  /* Closing the project cancels the write, if it did not happen yet */
+  task = g_task_new (NULL, project->priv->autosave_cancellable,
+                     glade_project_autosave_finish, NULL);
+  g_task_set_source_tag (task, glade_project_queue_autosave);
+  g_task_set_task_data (task, data, (GDestroyNotify) autosave_data_free);
+  g_task_run_in_thread (task, glade_project_autosave_thread);
+  g_object_unref (task);
+}
+
+static inline void
+update_project_resource_path (GladeProject *project, gchar *path)
+{
+  GFile *new_resource_path;
   GList *l;
 
   new_resource_path = g_file_new_for_path (path);
@@ -2889,6 +3508,10 @@ glade_project_save_verify (GladeProject      *project,
   if (!glade_project_verify (project, TRUE, flags))
     return FALSE;
 
+  /* Any autosave still being written is stale from now on */
+  project->priv->saves++;
+  project->priv->autosave_pending = FALSE;
+
   /* Delete any autosaves at this point, if they exist */
   if (project->priv->path)
     {
@@ -2966,32 +3589,184 @@ glade_project_save (GladeProject *project, const gchar *path, GError **error)
                                     error);
 }
 
+/* Collects @toplevel, every toplevel it depends on, directly or not, and
+ * the objects which are not widgets depending on them, like size groups
+ */
+static GHashTable *
+glade_project_get_preview_toplevels (GladeProject *project, GladeWidget *toplevel)
+{
+  GHashTable *toplevels = g_hash_table_new (NULL, NULL);
+  gboolean added = TRUE;
+  GList *edges, *l;
+
+  edges = glade_project_get_graph_deps (project);
+  edges = glade_project_add_hardcoded_dependencies (edges, project);
+
+  g_hash_table_add (toplevels, toplevel);
+
+  /* Edges go from a toplevel to the ones using it, follow them backwards.
+   * Follow them forwards too for objects which are not widgets, a size group
+   * or accel group using the previewed widgets is part of their behaviour.
+   */
+  while (added)
+    {
+      added = FALSE;
+
+      for (l = edges; l; l = g_list_next (l))
+        {
+          _NodeEdge *edge = l->data;
+
+          if (g_hash_table_contains (toplevels, edge->successor) &&
+              g_hash_table_add (toplevels, edge->predecessor))
+            added = TRUE;
+
+          if (g_hash_table_contains (toplevels, edge->predecessor) &&
+              !GTK_IS_WIDGET (glade_widget_get_object (edge->successor)) &&
+              g_hash_table_add (toplevels, edge->successor))
+            added = TRUE;
+        }
+    }
+
+  _node_edge_list_free (edges);
+
+  return toplevels;
+}
+
+/* Writes the UI definition previewed for @toplevel, split in chunks which
+ * are concatenated in order by the previewer: the document head, one
+ * chunk for @toplevel and each toplevel it depends on and the document
+ * tail. Unchanged toplevels always produce the same chunk, so the
+ * previewer does not need them again.
+ */
+GPtrArray *
+_glade_project_write_preview (GladeProject *project, GladeWidget *toplevel)
+{
+  GladeProjectPrivate *priv = project->priv;
+  GladeXmlContext *context;
+  GladeXmlNode *root, *node;
+  GHashTable *needed;
+  GList *toplevels, *l;
+  GPtrArray *chunks;
+  gchar *text, *mark, *dump;
+
+  g_return_val_if_fail (GLADE_IS_PROJECT (project), NULL);
+  g_return_val_if_fail (GLADE_IS_WIDGET (toplevel), NULL);
+
+  chunks = g_ptr_array_new_with_free_func (g_free);
+  g_ptr_array_add (chunks, NULL);
+
+  needed = glade_project_get_preview_toplevels (project, toplevel);
+  toplevels = glade_project_get_ordered_toplevels (project);
+  context = glade_project_write_document (project, &root);
+
+  priv->writing_preview = TRUE;
+
+  for (l = toplevels; l; l = g_list_next (l))
+    {
+      if (!g_hash_table_contains (needed, l->data) || glade_widget_get_parent (l->data))
+        continue;
+
+      glade_widget_write (l->data, context, root);
+
+      node = _glade_xml_node_get_last_child (root);
+      dump = _glade_xml_node_dump (node);
+      g_ptr_array_add (chunks, g_strconcat (dump, "\n  ", NULL));
+      glade_xml_node_remove (node);
+      glade_xml_node_delete (node);
+      g_free (dump);
+    }
+
+  priv->writing_preview = FALSE;
+
+  /* Split the rest of the document where the toplevels go, the mark is the
+   * last child of the root node so look for it from the end: the comments
+   * in the document head are the user's and might look just like it.
+   */
+  glade_xml_node_append_child (root,
+                               glade_xml_doc_new_comment (glade_xml_context_get_doc (context),
+                                                          PREVIEW_TOPLEVELS_MARK));
+  text = glade_xml_dump_from_context (context);
+  mark = g_strrstr (text, "<!--" PREVIEW_TOPLEVELS_MARK "-->");
+  g_assert (mark);
+
+  g_ptr_array_index (chunks, 0) = g_strndup (text, mark - text);
+  g_ptr_array_add (chunks, g_strdup (mark + strlen ("<!--" PREVIEW_TOPLEVELS_MARK "-->")));
+
+  g_free (text);
+  glade_xml_context_free (context);
+  g_list_free (toplevels);
+  g_hash_table_destroy (needed);
+
+  return chunks;
+}
+
+/* Sends the current state of @preview's toplevel to @preview, unless
+ * nothing changed since the last time and @present is %FALSE.
+ */
+static void
+glade_project_update_preview (GladeProject *project,
+                              GladePreview *preview,
+                              gboolean      present)
+{
+  GPtrArray *chunks;
+
+  /* The previewed widget might have been added to a parent since */
+  chunks = _glade_project_write_preview (project,
+                                         glade_widget_get_toplevel (glade_preview_get_widget (preview)));
+  _glade_preview_update_chunks (preview, chunks, present);
+  g_ptr_array_unref (chunks);
+}
+
+static gboolean
+preview_update_timeout (gpointer data)
+{
+  GladeProject *project = data;
+  GHashTableIter iter;
+  gpointer preview;
+
+  project->priv->preview_update_id = 0;
+
+  g_hash_table_iter_init (&iter, project->priv->previews);
+  while (g_hash_table_iter_next (&iter, NULL, &preview))
+    glade_project_update_preview (project, preview, FALSE);
+
+  return G_SOURCE_REMOVE;
+}
+
+/* Updates the running previews with the latest changes, changes made
+ * in a quick succession are sent together once per frame.
+ */
+static void
+glade_project_queue_preview_update (GladeProject *project)
+{
+  GladeProjectPrivate *priv = project->priv;
+
+  if (priv->preview_update_id || !priv->previews ||
+      g_hash_table_size (priv->previews) == 0)
+    return;
+
+  priv->preview_update_id = g_timeout_add (PREVIEW_UPDATE_INTERVAL,
+                                           preview_update_timeout, project);
+}
+
 /**
  * glade_project_preview:
  * @project: a #GladeProject
  * @gwidget: a #GladeWidget
  * 
  * Creates and displays a preview window holding a snapshot of @gwidget's
- * toplevel window in @project. Note that the preview window is only a snapshot
- * of the current state of the project, there is no limit on how many preview
- * snapshots can be taken.
+ * toplevel window in @project. The preview window is then kept up to date
+ * with the changes made to @project until it is closed, there is no limit
+ * on how many toplevels can be previewed at the same time.
  */
 void
 glade_project_preview (GladeProject *project, GladeWidget *gwidget)
 {
-  GladeXmlContext *context;
-  gchar *text, *pidstr;
+  gchar *pidstr;
   GladePreview *preview = NULL;
 
   g_return_if_fail (GLADE_IS_PROJECT (project));
 
-  project->priv->writing_preview = TRUE;
-  context = glade_project_write (project);
-  project->priv->writing_preview = FALSE;
-
-  text = glade_xml_dump_from_context (context);
-  glade_xml_context_free (context);
-
   gwidget = glade_widget_get_toplevel (gwidget);
   if (!GTK_IS_WIDGET (glade_widget_get_object (gwidget)))
     return;
@@ -3002,7 +3777,7 @@ glade_project_preview (GladeProject *project, GladeWidget *gwidget)
   if (!preview)
     {
       /* If the previewer program is somehow missing, this can return NULL */
-      preview = glade_preview_launch (gwidget, text);
+      preview = glade_preview_launch (gwidget, NULL);
       g_return_if_fail (GLADE_IS_PREVIEW (preview));
 
       /* Leave project data on the preview */
@@ -3023,12 +3798,8 @@ glade_project_preview (GladeProject *project, GladeWidget *gwidget)
                            glade_preview_get_pid_as_str (preview),
                            preview);
     }
-  else
-    {
-      glade_preview_update (preview, text);
-    }
 
-  g_free (text);
+  glade_project_update_preview (project, preview, TRUE);
 }
 
 gboolean
@@ -3364,6 +4135,13 @@ glade_project_verify_properties (GladeWidget *widget)
   if (!project || project->priv->loading)
     return;
 
+  if (project->priv->bulk_depth > 0)
+    {
+      if (!g_hash_table_contains (project->priv->bulk_verify, widget))
+        g_hash_table_add (project->priv->bulk_verify, g_object_ref (widget));
+      return;
+    }
+
   glade_project_verify_properties_internal (widget, NULL, NULL, TRUE,
                                             GLADE_VERIFY_VERSIONS     |
                                             GLADE_VERIFY_DEPRECATIONS |
@@ -3414,17 +4192,81 @@ glade_project_verify_dialog (GladeProject *project, GString *string)
 }
 
 
-gboolean
-glade_project_verify (GladeProject    *project,
-                      gboolean         saving,
-                      GladeVerifyFlags flags)
+/* Appends the problems found in @widget to @string, widgets are only
+ * verified again when they changed since the last time.
+ */
+static void
+glade_project_verify_widget (GladeProject    *project,
+                             GladeWidget     *widget,
+                             GString         *string,
+                             GladeVerifyFlags flags)
 {
   GladeProjectPrivate *priv = project->priv;
+  VerifyResult *result;
+  gchar *path_name = NULL;
+
+  if ((result = g_hash_table_lookup (priv->verify_cache, widget)) != NULL)
+    {
+      if (result->flags != flags)
+        result = NULL;
+      else if (result->message)
+        {
+          /* Renaming or moving an ancestor changes the path in the message */
+          path_name = glade_widget_generate_path_name (widget);
+
+          if (strcmp (path_name, result->path_name) != 0)
+            result = NULL;
+        }
+    }
+
+  if (result == NULL)
+    {
+      GString *message = g_string_new (NULL);
+
+      if (!path_name)
+        path_name = glade_widget_generate_path_name (widget);
+
+      GLADE_NOTE (VERIFY, g_print ("VERIFY: verifying %s\n", path_name));
+
+      glade_project_verify_adaptor (project, glade_widget_get_adaptor (widget),
+                                    path_name, message, flags, FALSE, NULL);
+      glade_project_verify_properties_internal (widget, path_name, message, FALSE, flags);
+      glade_project_verify_signals (widget, path_name, message, FALSE, flags);
+
+      result = g_slice_new0 (VerifyResult);
+      result->flags = flags;
+
+      if (message->len > 0)
+        {
+          result->path_name = path_name;
+          path_name = NULL;
+        }
+
+      result->message = g_string_free (message, message->len == 0);
+      g_hash_table_insert (priv->verify_cache, widget, result);
+    }
+
+  if (result->message)
+    g_string_append (string, result->message);
+
+  g_free (path_name);
+}
+
+/* Checks whether @widget was verified and did not change since */
+gboolean
+_glade_project_widget_is_verified (GladeProject *project, GladeWidget *widget)
+{
+  g_return_val_if_fail (GLADE_IS_PROJECT (project), FALSE);
+
+  return g_hash_table_contains (project->priv->verify_cache, widget);
+}
+
+/* Returns the problems found in @project, one or more lines each */
+static GString *
+glade_project_verify_string (GladeProject *project, GladeVerifyFlags flags)
+{
   GString *string = g_string_new (NULL);
   GList *list;
-  gboolean ret = TRUE;
-
-  GLADE_NOTE (VERIFY, g_print ("VERIFY: glade_project_verify() start\n"));
 
   if (project->priv->template)
     {
@@ -3452,17 +4294,46 @@ glade_project_verify (GladeProject    *project,
           g_free (type);
         }
       else
-        {
-          gchar *path_name = glade_widget_generate_path_name (widget);
+        glade_project_verify_widget (project, widget, string, flags);
+    }
 
-          glade_project_verify_adaptor (project, glade_widget_get_adaptor (widget),
-                                        path_name, string, flags, FALSE, NULL);
-          glade_project_verify_properties_internal (widget, path_name, string, FALSE, flags);
-          glade_project_verify_signals (widget, path_name, string, FALSE, flags);
+  return string;
+}
 
-          g_free (path_name);
-        }
-    }
+/**
+ * _glade_project_verify_message:
+ * @project: a #GladeProject
+ * @flags: the #GladeVerifyFlags to check
+ *
+ * Verifies @project without reporting the problems found to the user.
+ *
+ * Returns: (transfer full) (nullable): the problems found, as markup, or
+ *          %NULL if there are none
+ */
+gchar *
+_glade_project_verify_message (GladeProject *project, GladeVerifyFlags flags)
+{
+  GString *string;
+
+  g_return_val_if_fail (GLADE_IS_PROJECT (project), NULL);
+
+  string = glade_project_verify_string (project, flags);
+
+  return g_string_free (string, string->len == 0);
+}
+
+gboolean
+glade_project_verify (GladeProject    *project,
+                      gboolean         saving,
+                      GladeVerifyFlags flags)
+{
+  GladeProjectPrivate *priv = project->priv;
+  GString *string;
+  gboolean ret = TRUE;
+
+  GLADE_NOTE (VERIFY, g_print ("VERIFY: glade_project_verify() start\n"));
+
+  string = glade_project_verify_string (project, flags);
 
   /* Update project warnings */
   _glade_project_properties_set_warnings (GLADE_PROJECT_PROPERTIES (priv->prefs_dialog),
@@ -3653,24 +4524,10 @@ glade_project_verify_project_for_ui (GladeProject *project)
 GladeWidget *
 glade_project_get_widget_by_name (GladeProject *project, const gchar *name)
 {
-  GList *list;
-
   g_return_val_if_fail (GLADE_IS_PROJECT (project), NULL);
   g_return_val_if_fail (name != NULL, NULL);
 
-  for (list = project->priv->objects; list; list = list->next)
-    {
-      GladeWidget *widget;
-      gchar *widget_name;
-
-      widget = glade_widget_get_from_gobject (list->data);
-      widget_name = glade_widget_get_name (widget);
-
-      if (g_strcmp0 (widget_name, name) == 0)
-        return widget;
-    }
-
-  return NULL;
+  return g_hash_table_lookup (project->priv->widgets_by_name, name);
 }
 
 static void
@@ -3678,7 +4535,13 @@ glade_project_release_widget_name (GladeProject *project,
                                    GladeWidget  *gwidget,
                                    const char   *widget_name)
 {
-  glade_name_context_release_name (project->priv->widget_names, widget_name);
+  GladeProjectPrivate *priv = project->priv;
+
+  glade_name_context_release_name (priv->widget_names, widget_name);
+
+  /* Only drop the index entry if it still points to this widget */
+  if (g_hash_table_lookup (priv->widgets_by_name, widget_name) == gwidget)
+    g_hash_table_remove (priv->widgets_by_name, widget_name);
 }
 
 /**
@@ -3717,8 +4580,10 @@ glade_project_reserve_widget_name (GladeProject *project,
       return;
     }
 
-  /* Add to name context */
+  /* Add to name context and index the widget by its name */
   glade_name_context_add_name (project->priv->widget_names, widget_name);
+  g_hash_table_insert (project->priv->widgets_by_name,
+                       g_strdup (widget_name), gwidget);
 }
 
 /**
@@ -3755,61 +4620,16 @@ glade_project_get_iter_for_object (GladeProject *project,
                                    GladeWidget  *widget,
                                    GtkTreeIter  *iter)
 {
-  GtkTreeModel *model = project->priv->model;
-  GladeWidget *widget_iter = widget;
-  GList *parent_node, *hierarchy = NULL;
-  gboolean iter_valid;
+  GtkTreeIter *row;
 
   g_return_val_if_fail (widget, FALSE);
   g_return_val_if_fail (GLADE_IS_WIDGET (widget), FALSE);
 
-  if (!(iter_valid = gtk_tree_model_get_iter_first (model, iter)))
+  if ((row = g_hash_table_lookup (project->priv->iters, widget)) == NULL)
     return FALSE;
 
-  /* Generate widget hierarchy list */
-  while ((widget_iter = glade_widget_get_parent (widget_iter)))
-    hierarchy = g_list_prepend (hierarchy, widget_iter);
-
-  parent_node = hierarchy;
-
-  do
-    {
-      gtk_tree_model_get (model, iter, 0, &widget_iter, -1);
-      g_object_unref (widget_iter);
-      
-      if (widget_iter == widget)
-        {
-          /* Object found */
-          g_list_free (hierarchy);
-          return TRUE;
-        }
-      else if (parent_node && widget_iter == parent_node->data)
-        {
-          GtkTreeIter child_iter;
-
-          if (gtk_tree_model_iter_children (model, &child_iter, iter))
-            {
-              /* Parent found, adn child iter updated, continue looking */
-              parent_node = g_list_next (parent_node);
-              *iter = child_iter;
-              continue;
-            }
-          else
-            {
-              /* Parent with no children? */
-              g_warning ("Discrepancy found in TreeModel data proxy. "
-                         "Can not get children iter for widget %s", 
-                         glade_widget_get_name (widget_iter));
-              break;
-            }
-        }
-      
-      iter_valid = gtk_tree_model_iter_next (model, iter);
-
-    } while (iter_valid);
-
-  g_list_free (hierarchy);
-  return FALSE;
+  *iter = *row;
+  return TRUE;
 }
 
 /**
@@ -3847,6 +4667,9 @@ glade_project_set_widget_name (GladeProject *project,
   glade_project_release_widget_name (project, widget, glade_widget_get_name (widget));
   glade_widget_set_name (widget, new_name);
 
+  /* Toplevels are sorted by name */
+  glade_project_invalidate_toplevels_order (project);
+
   g_signal_emit (G_OBJECT (project),
                  glade_project_signals[WIDGET_NAME_CHANGED], 0, widget);
 
@@ -3875,6 +4698,14 @@ glade_project_check_reordered (GladeProject *project,
   g_return_if_fail (glade_project_has_object (project,
                                               glade_widget_get_object (parent)));
 
+  /* Some rows may not be there yet, reorder them once they are */
+  if (project->priv->bulk_depth > 0)
+    {
+      if (!g_hash_table_contains (project->priv->bulk_reordered, parent))
+        g_hash_table_add (project->priv->bulk_reordered, g_object_ref (parent));
+      return;
+    }
+
   new_order = glade_widget_get_children (parent);
 
   /* Check if the list changed */
@@ -3886,58 +4717,216 @@ glade_project_check_reordered (GladeProject *project,
         break;
     }
 
-  if (l || ll)
+  if (l || ll)
+    {
+      gint *order = g_new0 (gint, g_list_length (new_order));
+      GtkTreeIter iter;
+      gint i;
+
+      for (i = 0, l = new_order; l; l = g_list_next (l))
+        {
+          GObject *obj = l->data;
+          GList *node = g_list_find (old_order, obj);
+
+          g_assert (node);
+
+          order[i] = g_list_position (old_order, node);
+          i++;
+        }
+
+      _glade_project_write_cache_invalidate (project, parent);
+
+      /* Signal that the rows were reordered */
+      glade_project_get_iter_for_object (project, parent, &iter);
+      gtk_tree_store_reorder (GTK_TREE_STORE (project->priv->model), &iter, order);
+
+      g_free (order);
+    }
+
+  g_list_free (new_order);
+}
+
+static inline gboolean
+glade_project_has_gwidget (GladeProject *project, GladeWidget *gwidget)
+{
+  return (glade_widget_get_project (gwidget) == project && 
+           glade_widget_in_project (gwidget));
+}
+
+/* Appends the row of @gwidget to its parent row */
+static void
+glade_project_insert_row (GladeProject *project, GladeWidget *gwidget)
+{
+  GtkTreeIter iter, parent_iter, *parent = NULL;
+  GladeWidget *gparent;
+
+  if ((gparent = glade_widget_get_parent (gwidget)) != NULL &&
+      glade_project_get_iter_for_object (project, gparent, &parent_iter))
+    parent = &parent_iter;
+
+  gtk_tree_store_insert_with_values (GTK_TREE_STORE (project->priv->model), &iter, parent, -1,
+                                     0, gwidget, -1);
+  g_hash_table_insert (project->priv->iters, gwidget, gtk_tree_iter_copy (&iter));
+}
+
+/* Reorders the children rows of @gwidget after its children */
+static void
+glade_project_sync_rows_order (GladeProject *project, GladeWidget *gwidget)
+{
+  GtkTreeModel *model = project->priv->model;
+  GtkTreeIter iter, child;
+  GPtrArray *rows;
+  GList *children, *l;
+  gboolean reordered = FALSE;
+  gint *order, n = 0;
+  guint index;
+
+  if (!glade_project_get_iter_for_object (project, gwidget, &iter) ||
+      !gtk_tree_model_iter_children (model, &child, &iter))
+    return;
+
+  rows = g_ptr_array_new ();
+  do
+    {
+      GladeWidget *row_widget;
+
+      gtk_tree_model_get (model, &child, 0, &row_widget, -1);
+      g_ptr_array_add (rows, row_widget);
+      g_object_unref (row_widget);
+    }
+  while (gtk_tree_model_iter_next (model, &child));
+
+  order = g_new (gint, rows->len);
+  children = glade_widget_get_children (gwidget);
+
+  for (l = children; l && n < (gint) rows->len; l = g_list_next (l))
+    {
+      if (g_ptr_array_find (rows, glade_widget_get_from_gobject (l->data), &index))
+        {
+          reordered |= (index != (guint) n);
+          order[n++] = index;
+        }
+    }
+
+  if (reordered && n == (gint) rows->len)
+    {
+      _glade_project_write_cache_invalidate (project, gwidget);
+      gtk_tree_store_reorder (GTK_TREE_STORE (model), &iter, order);
+    }
+
+  g_list_free (children);
+  g_ptr_array_unref (rows);
+  g_free (order);
+}
+
+/**
+ * glade_project_begin_bulk_update:
+ * @project: a #GladeProject
+ *
+ * Starts a bulk update of @project, use it around code adding or removing
+ * several objects. Until the matching glade_project_end_bulk_update() the
+ * tree model rows and "add-widget" signals of the added objects, property
+ * verification and "selection-changed" are held back, and then done in one
+ * pass followed by a single "objects-changed" signal.
+ *
+ * Bulk updates can be nested, only the outermost one takes effect.
+ */
+void
+glade_project_begin_bulk_update (GladeProject *project)
+{
+  GladeProjectPrivate *priv;
+
+  g_return_if_fail (GLADE_IS_PROJECT (project));
+
+  priv = project->priv;
+
+  if (priv->bulk_depth++ > 0)
+    return;
+
+  priv->bulk_added = g_ptr_array_new_with_free_func (g_object_unref);
+  priv->bulk_removed = g_ptr_array_new_with_free_func (g_object_unref);
+  priv->bulk_verify = g_hash_table_new_full (NULL, NULL, g_object_unref, NULL);
+  priv->bulk_reordered = g_hash_table_new_full (NULL, NULL, g_object_unref, NULL);
+}
+
+/**
+ * glade_project_end_bulk_update:
+ * @project: a #GladeProject
+ *
+ * Ends a bulk update started with glade_project_begin_bulk_update().
+ */
+void
+glade_project_end_bulk_update (GladeProject *project)
+{
+  GladeProjectPrivate *priv;
+  GPtrArray *added, *removed;
+  GHashTable *verify, *reordered;
+  gboolean selection_changed;
+  GHashTableIter iter;
+  gpointer widget;
+  guint i;
+
+  g_return_if_fail (GLADE_IS_PROJECT (project));
+  g_return_if_fail (project->priv->bulk_depth > 0);
+
+  priv = project->priv;
+
+  if (--priv->bulk_depth > 0)
+    return;
+
+  /* Handlers may start bulk updates of their own */
+  added = g_steal_pointer (&priv->bulk_added);
+  removed = g_steal_pointer (&priv->bulk_removed);
+  verify = g_steal_pointer (&priv->bulk_verify);
+  reordered = g_steal_pointer (&priv->bulk_reordered);
+  selection_changed = priv->bulk_selection_changed;
+  priv->bulk_selection_changed = FALSE;
+
+  /* Parents were added before their children, so are their rows */
+  for (i = 0; i < added->len; i++)
     {
-      gint *order = g_new0 (gint, g_list_length (new_order));
-      GtkTreeIter iter;
-      gint i;
+      GladeWidget *gwidget = g_ptr_array_index (added, i);
 
-      for (i = 0, l = new_order; l; l = g_list_next (l))
-        {
-          GObject *obj = l->data;
-          GList *node = g_list_find (old_order, obj);
+      if (glade_project_has_gwidget (project, gwidget) &&
+          !g_hash_table_contains (priv->iters, gwidget))
+        glade_project_insert_row (project, gwidget);
+    }
 
-          g_assert (node);
+  g_hash_table_iter_init (&iter, reordered);
+  while (g_hash_table_iter_next (&iter, &widget, NULL))
+    if (glade_project_has_gwidget (project, widget))
+      glade_project_sync_rows_order (project, widget);
 
-          order[i] = g_list_position (old_order, node);
-          i++;
-        }
+  /* Update user visible compatibility info */
+  g_hash_table_iter_init (&iter, verify);
+  while (g_hash_table_iter_next (&iter, &widget, NULL))
+    if (glade_project_has_gwidget (project, widget))
+      glade_project_verify_properties (widget);
 
-      /* Signal that the rows were reordered */
-      glade_project_get_iter_for_object (project, parent, &iter);
-      gtk_tree_store_reorder (GTK_TREE_STORE (project->priv->model), &iter, order);
+  for (i = 0; i < added->len; i++)
+    g_signal_emit (G_OBJECT (project),
+                   glade_project_signals[ADD_WIDGET], 0, g_ptr_array_index (added, i));
 
-      g_free (order);
-    }
+  if (added->len || removed->len)
+    g_signal_emit (G_OBJECT (project),
+                   glade_project_signals[OBJECTS_CHANGED], 0, added, removed);
 
-  g_list_free (new_order);
-}
+  if (selection_changed)
+    glade_project_selection_changed (project);
 
-static inline gboolean
-glade_project_has_gwidget (GladeProject *project, GladeWidget *gwidget)
-{
-  return (glade_widget_get_project (gwidget) == project && 
-           glade_widget_in_project (gwidget));
+  g_ptr_array_unref (added);
+  g_ptr_array_unref (removed);
+  g_hash_table_destroy (verify);
+  g_hash_table_destroy (reordered);
 }
 
-/**
- * glade_project_add_object:
- * @project: the #GladeProject the widget is added to
- * @object: the #GObject to add
- *
- * Adds an object to the project.
- */
-void
-glade_project_add_object (GladeProject *project, GObject *object)
+static void
+glade_project_add_object_internal (GladeProject *project, GObject *object)
 {
   GladeProjectPrivate *priv;
   GladeWidget *gwidget;
   GList *list, *children;
   const gchar *name;
-  GtkTreeIter iter, *parent = NULL;
-
-  g_return_if_fail (GLADE_IS_PROJECT (project));
-  g_return_if_fail (G_IS_OBJECT (object));
 
   /* We don't list placeholders */
   if (GLADE_IS_PLACEHOLDER (object))
@@ -3987,34 +4976,47 @@ glade_project_add_object (GladeProject *project, GObject *object)
   /* Be sure to update the lists before emitting signals */
   if (glade_widget_get_parent (gwidget) == NULL)
     priv->tree = g_list_append (priv->tree, object);
-  else if (glade_project_get_iter_for_object (project,
-                                              glade_widget_get_parent (gwidget),
-                                              &iter))
-    {
-      parent = &iter;
-    }
 
   priv->objects = g_list_prepend (priv->objects, object);
-  gtk_tree_store_insert_with_values (GTK_TREE_STORE (priv->model), NULL, parent, -1,
-                                     0, gwidget, -1);
 
-  /* NOTE: Sensitive ordering here, we need to recurse after updating
-   * the tree model listeners (and update those listeners after our
-   * internal lists have been resolved), otherwise children are added
-   * before the parents (and the views dont like that).
+  if (glade_widget_has_prop_refs (gwidget))
+    g_hash_table_add (priv->referenced, gwidget);
+  glade_project_invalidate_toplevels_order (project);
+  _glade_project_write_cache_invalidate (project, gwidget);
+
+  /* NOTE: Sensitive ordering here, the row is inserted when the bulk update
+   * ends and children are added after their parents, otherwise children
+   * are added before the parents (and the views dont like that).
    */
+  g_ptr_array_add (priv->bulk_added, g_object_ref (gwidget));
+
   if ((children = glade_widget_get_children (gwidget)) != NULL)
     {
       for (list = children; list && list->data; list = list->next)
-        glade_project_add_object (project, G_OBJECT (list->data));
+        glade_project_add_object_internal (project, G_OBJECT (list->data));
       g_list_free (children);
     }
 
   /* Update user visible compatibility info */
   glade_project_verify_properties (gwidget);
+}
 
-  g_signal_emit (G_OBJECT (project),
-                 glade_project_signals[ADD_WIDGET], 0, gwidget);
+/**
+ * glade_project_add_object:
+ * @project: the #GladeProject the widget is added to
+ * @object: the #GObject to add
+ *
+ * Adds an object to the project.
+ */
+void
+glade_project_add_object (GladeProject *project, GObject *object)
+{
+  g_return_if_fail (GLADE_IS_PROJECT (project));
+  g_return_if_fail (G_IS_OBJECT (object));
+
+  glade_project_begin_bulk_update (project);
+  glade_project_add_object_internal (project, object);
+  glade_project_end_bulk_update (project);
 }
 
 /**
@@ -4049,34 +5051,44 @@ glade_project_widget_changed (GladeProject *project, GladeWidget *gwidget)
   g_return_if_fail (GLADE_IS_WIDGET (gwidget));
   g_return_if_fail (glade_project_has_gwidget (project, gwidget));
 
-  glade_project_get_iter_for_object (project, gwidget, &iter);
+  /* The row is inserted when the bulk update adding it ends */
+  if (!glade_project_get_iter_for_object (project, gwidget, &iter))
+    return;
+
   path = gtk_tree_model_get_path (project->priv->model, &iter);
   gtk_tree_model_row_changed (project->priv->model, path, &iter);
   gtk_tree_path_free (path);
 }
 
-/**
- * glade_project_remove_object:
- * @project: a #GladeProject
- * @object: the #GObject to remove
- *
- * Removes @object from @project.
- *
- * Note that when removing the #GObject from the project we
- * don't change ->project in the associated #GladeWidget; this
- * way UNDO can work.
- */
-void
-glade_project_remove_object (GladeProject *project, GObject *object)
+static gboolean
+glade_project_selection_remove_internal (GladeProject *project, GObject *object)
+{
+  GladeProjectPrivate *priv = project->priv;
+  GList *link;
+
+  if ((link = g_hash_table_lookup (priv->selection_links, object)) == NULL)
+    return FALSE;
+
+  g_hash_table_remove (priv->selection_links, object);
+  priv->selection = g_list_delete_link (priv->selection, link);
+
+  if (priv->selection == NULL)
+    glade_project_set_has_selection (project, FALSE);
+
+  return TRUE;
+}
+
+static void
+glade_project_remove_object_internal (GladeProject *project,
+                                      GObject      *object,
+                                      gboolean     *selection_changed)
 {
   GladeWidget *gwidget;
   GList *list, *children;
   gchar *preview_pid;
+  gboolean pending;
   GtkTreeIter iter;
 
-  g_return_if_fail (GLADE_IS_PROJECT (project));
-  g_return_if_fail (G_IS_OBJECT (object));
-
   if (GLADE_IS_PLACEHOLDER (object))
     return;
 
@@ -4086,7 +5098,8 @@ glade_project_remove_object (GladeProject *project, GObject *object)
         {
           project->priv->tree = g_list_remove_all (project->priv->tree, object);
           project->priv->objects = g_list_remove_all (project->priv->objects, object);
-          project->priv->selection = g_list_remove_all (project->priv->selection, object);
+          if (glade_project_selection_remove_internal (project, object))
+            *selection_changed = TRUE;
           g_warning ("Internal data model error, removing object %p %s without a GladeWidget wrapper",
                      object, G_OBJECT_TYPE_NAME (object));
         }
@@ -4100,7 +5113,8 @@ glade_project_remove_object (GladeProject *project, GObject *object)
   if ((children = glade_widget_get_children (gwidget)) != NULL)
     {
       for (list = children; list && list->data; list = list->next)
-        glade_project_remove_object (project, G_OBJECT (list->data));
+        glade_project_remove_object_internal (project, G_OBJECT (list->data),
+                                              selection_changed);
       g_list_free (children);
     }
 
@@ -4109,20 +5123,39 @@ glade_project_remove_object (GladeProject *project, GObject *object)
     gtk_main_iteration ();
 
   /* Remove selection and release name from the name context */
-  glade_project_selection_remove (project, object, TRUE);
+  if (glade_project_selection_remove_internal (project, object))
+    *selection_changed = TRUE;
   glade_project_release_widget_name (project, gwidget,
                                      glade_widget_get_name (gwidget));
 
-  g_signal_emit (G_OBJECT (project),
-                 glade_project_signals[REMOVE_WIDGET], 0, gwidget);
+  /* Nobody heard of a widget added in this same bulk update, handlers of
+   * "remove-widget" still expect the widget in place though, so the
+   * other ones are notified right away.
+   */
+  if (!(pending = g_ptr_array_remove (project->priv->bulk_added, gwidget)))
+    {
+      g_signal_emit (G_OBJECT (project),
+                     glade_project_signals[REMOVE_WIDGET], 0, gwidget);
+      g_ptr_array_add (project->priv->bulk_removed, g_object_ref (gwidget));
+    }
+
+  /* Nothing is left to verify or reorder once it is gone */
+  g_hash_table_remove (project->priv->bulk_verify, gwidget);
+  g_hash_table_remove (project->priv->bulk_reordered, gwidget);
 
   /* Update internal data structure (remove from lists) */
   project->priv->tree = g_list_remove (project->priv->tree, object);
   project->priv->objects = g_list_remove (project->priv->objects, object);
+  g_hash_table_remove (project->priv->referenced, gwidget);
+  glade_project_invalidate_toplevels_order (project);
+  _glade_project_write_cache_invalidate (project, gwidget);
   
   if (glade_project_get_iter_for_object (project, gwidget, &iter))
-    gtk_tree_store_remove (GTK_TREE_STORE (project->priv->model), &iter);
-  else
+    {
+      gtk_tree_store_remove (GTK_TREE_STORE (project->priv->model), &iter);
+      g_hash_table_remove (project->priv->iters, gwidget);
+    }
+  else if (!pending)
     g_warning ("Internal data model error, object %p %s not found in tree model",
                object, G_OBJECT_TYPE_NAME (object));
   
@@ -4135,6 +5168,36 @@ glade_project_remove_object (GladeProject *project, GObject *object)
   g_object_unref (gwidget);
 }
 
+/**
+ * glade_project_remove_object:
+ * @project: a #GladeProject
+ * @object: the #GObject to remove
+ *
+ * Removes @object from @project.
+ *
+ * Note that when removing the #GObject from the project we
+ * don't change ->project in the associated #GladeWidget; this
+ * way UNDO can work.
+ */
+void
+glade_project_remove_object (GladeProject *project, GObject *object)
+{
+  gboolean selection_changed = FALSE;
+
+  g_return_if_fail (GLADE_IS_PROJECT (project));
+  g_return_if_fail (G_IS_OBJECT (object));
+
+  glade_project_begin_bulk_update (project);
+
+  glade_project_remove_object_internal (project, object, &selection_changed);
+
+  /* Notify selection changes once for the whole removed hierarchy */
+  if (selection_changed)
+    glade_project_selection_changed (project);
+
+  glade_project_end_bulk_update (project);
+}
+
 /*******************************************************************
  *                          Other API                              *
  *******************************************************************/
@@ -4240,6 +5303,7 @@ glade_project_set_template (GladeProject *project, GladeWidget *widget)
       if (project->priv->template)
         glade_widget_set_is_composite (project->priv->template, TRUE);
 
+      _glade_project_write_cache_invalidate (project, NULL);
       glade_project_verify_project_for_ui (project);
 
       g_object_notify_by_pspec (G_OBJECT (project), glade_project_props[PROP_TEMPLATE]);
@@ -4302,16 +5366,27 @@ glade_project_set_target_version (GladeProject *project,
                                   gint          major,
                                   gint          minor)
 {
+  gpointer value;
+
   g_return_if_fail (GLADE_IS_PROJECT (project));
   g_return_if_fail (catalog && catalog[0]);
   g_return_if_fail (major >= 0);
   g_return_if_fail (minor >= 0);
 
+  /* Nothing to verify again */
+  if (g_hash_table_lookup_extended (project->priv->target_versions_major,
+                                    catalog, NULL, &value) &&
+      GPOINTER_TO_INT (value) == major &&
+      GPOINTER_TO_INT (g_hash_table_lookup (project->priv->target_versions_minor,
+                                            catalog)) == minor)
+    return;
+
   g_hash_table_insert (project->priv->target_versions_major,
                        g_strdup (catalog), GINT_TO_POINTER ((int) major));
   g_hash_table_insert (project->priv->target_versions_minor,
                        g_strdup (catalog), GINT_TO_POINTER ((int) minor));
 
+  _glade_project_write_cache_invalidate (project, NULL);
   glade_project_verify_project_for_ui (project);
 
   g_signal_emit (project, glade_project_signals[TARGETS_CHANGED], 0);
@@ -4382,6 +5457,13 @@ glade_project_selection_changed (GladeProject *project)
 {
   g_return_if_fail (GLADE_IS_PROJECT (project));
 
+  /* Emitted once the bulk update ends */
+  if (project->priv->bulk_depth > 0)
+    {
+      project->priv->bulk_selection_changed = TRUE;
+      return;
+    }
+
   g_signal_emit (G_OBJECT (project),
                  glade_project_signals[SELECTION_CHANGED], 0);
 
@@ -4446,7 +5528,7 @@ gboolean
 glade_project_is_selected (GladeProject *project, GObject *object)
 {
   g_return_val_if_fail (GLADE_IS_PROJECT (project), FALSE);
-  return (g_list_find (project->priv->selection, object)) != NULL;
+  return g_hash_table_contains (project->priv->selection_links, object);
 }
 
 /**
@@ -4476,6 +5558,7 @@ glade_project_selection_clear (GladeProject *project, gboolean emit_signal)
 
   g_list_free (project->priv->selection);
   project->priv->selection = NULL;
+  g_hash_table_remove_all (project->priv->selection_links);
   glade_project_set_has_selection (project, FALSE);
 
   if (emit_signal)
@@ -4501,15 +5584,65 @@ glade_project_selection_remove (GladeProject *project,
   g_return_if_fail (GLADE_IS_PROJECT (project));
   g_return_if_fail (G_IS_OBJECT (object));
 
+  if (glade_project_selection_remove_internal (project, object) && emit_signal)
+    glade_project_selection_changed (project);
+}
+
+/**
+ * glade_project_selection_remove_many:
+ * @project: a #GladeProject
+ * @objects: (element-type GObject): a #GList of #GObject in @project
+ * @emit_signal: whether or not to emit a signal 
+ *               indicating a selection change
+ *
+ * Removes all @objects from the selection chain of @project
+ *
+ * If @emit_signal is %TRUE and the selection changed, calls
+ * glade_project_selection_changed() once.
+ */
+void
+glade_project_selection_remove_many (GladeProject *project,
+                                     GList        *objects,
+                                     gboolean      emit_signal)
+{
+  gboolean changed = FALSE;
+  GList *l;
+
+  g_return_if_fail (GLADE_IS_PROJECT (project));
+
+  /* Check the whole list first, the selection is left alone on errors */
+  for (l = objects; l; l = l->next)
+    g_return_if_fail (G_IS_OBJECT (l->data));
+
+  for (l = objects; l; l = l->next)
+    if (glade_project_selection_remove_internal (project, l->data))
+      changed = TRUE;
+
+  if (changed && emit_signal)
+    glade_project_selection_changed (project);
+}
+
+static gboolean
+glade_project_selection_add_internal (GladeProject *project, GObject *object)
+{
+  GladeProjectPrivate *priv = project->priv;
+  gboolean toggle_has_selection;
+
   if (glade_project_is_selected (project, object))
-    {
-      project->priv->selection =
-          g_list_remove (project->priv->selection, object);
-      if (project->priv->selection == NULL)
-        glade_project_set_has_selection (project, FALSE);
-      if (emit_signal)
-        glade_project_selection_changed (project);
-    }
+    return FALSE;
+
+  toggle_has_selection = (priv->selection == NULL);
+
+  if (GTK_IS_WIDGET (object))
+    gtk_widget_queue_draw (GTK_WIDGET (object));
+
+  priv->selection = g_list_prepend (priv->selection, object);
+  g_hash_table_insert (priv->selection_links, object, priv->selection);
+
+  if (toggle_has_selection)
+    glade_project_set_has_selection (project, TRUE);
+
+  return TRUE;
 }
 
 /**
@@ -4532,22 +5665,45 @@ glade_project_selection_add (GladeProject *project,
   g_return_if_fail (G_IS_OBJECT (object));
   g_return_if_fail (glade_project_has_object (project, object));
 
-  if (glade_project_is_selected (project, object) == FALSE)
-    {
-      gboolean toggle_has_selection = (project->priv->selection == NULL);
-
-      if (GTK_IS_WIDGET (object))
-        gtk_widget_queue_draw (GTK_WIDGET (object));
+  if (glade_project_selection_add_internal (project, object) && emit_signal)
+    glade_project_selection_changed (project);
+}
 
-      project->priv->selection =
-        g_list_prepend (project->priv->selection, object);
+/**
+ * glade_project_selection_add_many:
+ * @project: a #GladeProject
+ * @objects: (element-type GObject): a #GList of #GObject in @project
+ * @emit_signal: whether or not to emit a signal indicating 
+ *               a selection change
+ *
+ * Adds all @objects to the selection chain of @project
+ *
+ * If @emit_signal is %TRUE and the selection changed, calls
+ * glade_project_selection_changed() once.
+ */
+void
+glade_project_selection_add_many (GladeProject *project,
+                                  GList        *objects,
+                                  gboolean      emit_signal)
+{
+  gboolean changed = FALSE;
+  GList *l;
 
-      if (toggle_has_selection)
-        glade_project_set_has_selection (project, TRUE);
+  g_return_if_fail (GLADE_IS_PROJECT (project));
 
-      if (emit_signal)
-        glade_project_selection_changed (project);
+  /* Check the whole list first, the selection is left alone on errors */
+  for (l = objects; l; l = l->next)
+    {
+      g_return_if_fail (G_IS_OBJECT (l->data));
+      g_return_if_fail (glade_project_has_object (project, l->data));
     }
+
+  for (l = objects; l; l = l->next)
+    if (glade_project_selection_add_internal (project, l->data))
+      changed = TRUE;
+
+  if (changed && emit_signal)
+    glade_project_selection_changed (project);
 }
 
 /**
@@ -4571,7 +5727,7 @@ glade_project_selection_set (GladeProject *project,
   g_return_if_fail (glade_project_has_object (project, object));
 
   if (glade_project_is_selected (project, object) == FALSE ||
-      g_list_length (project->priv->selection) != 1)
+      g_hash_table_size (project->priv->selection_links) != 1)
     {
       glade_project_selection_clear (project, FALSE);
       glade_project_selection_add (project, object, emit_signal);
@@ -4716,6 +5872,70 @@ glade_project_push_undo (GladeProject *project, GladeCommand *cmd)
   GLADE_PROJECT_GET_CLASS (project)->push_undo (project, cmd);
 }
 
+/**
+ * glade_project_set_undo_limits:
+ * @project: a #GladeProject
+ * @max_commands: the maximum amount of commands to keep, or 0 for no limit
+ * @max_size: the maximum estimated memory in bytes held by the kept
+ *            commands, or 0 for no limit
+ *
+ * Bounds the undo history of @project, the oldest commands are dropped
+ * whenever one of the limits is exceeded. The last command that can be
+ * undone is always kept, and command groups are only dropped as a whole.
+ */
+void
+glade_project_set_undo_limits (GladeProject *project,
+                               guint         max_commands,
+                               gsize         max_size)
+{
+  g_return_if_fail (GLADE_IS_PROJECT (project));
+
+  project->priv->undo_max_commands = max_commands;
+  project->priv->undo_max_size = max_size;
+
+  glade_project_trim_undo (project);
+}
+
+/**
+ * glade_project_set_undo_compaction:
+ * @project: a #GladeProject
+ * @compaction: whether to compact the older undo history
+ *
+ * Sets whether consecutive commands which can be unified, such as
+ * successive changes to the same property, should be merged into a
+ * single command once they are not among the most recent ones.
+ */
+void
+glade_project_set_undo_compaction (GladeProject *project,
+                                   gboolean      compaction)
+{
+  g_return_if_fail (GLADE_IS_PROJECT (project));
+
+  project->priv->undo_compaction = compaction;
+}
+
+/**
+ * glade_project_get_undo_size:
+ * @project: a #GladeProject
+ * @n_commands: (out) (optional): location to store the amount of commands
+ *
+ * Reports the memory used by the undo history of @project, see
+ * glade_command_get_size().
+ *
+ * Returns: the estimated memory in bytes held by the undo and redo commands
+ */
+gsize
+glade_project_get_undo_size (GladeProject *project,
+                             guint        *n_commands)
+{
+  g_return_val_if_fail (GLADE_IS_PROJECT (project), 0);
+
+  if (n_commands)
+    *n_commands = project->priv->undo_stack.length;
+
+  return project->priv->undo_size;
+}
+
 static GList *
 walk_command (GList *list, gboolean forward)
 {
@@ -4753,12 +5973,12 @@ undo_item_activated (GtkMenuItem *item, GladeProject *project)
   GladeCommand *cmd = g_object_get_data (G_OBJECT (item), "command-data");
   GladeCommand *next_cmd;
 
-  index = g_list_index (project->priv->undo_stack, cmd);
+  index = g_queue_index (&project->priv->undo_stack, cmd);
 
   do
     {
       next_cmd = glade_project_next_undo_item (project);
-      next_index = g_list_index (project->priv->undo_stack, next_cmd);
+      next_index = g_queue_index (&project->priv->undo_stack, next_cmd);
 
       glade_project_undo (project);
 
@@ -4774,12 +5994,12 @@ redo_item_activated (GtkMenuItem *item, GladeProject *project)
   GladeCommand *cmd = g_object_get_data (G_OBJECT (item), "command-data");
   GladeCommand *next_cmd;
 
-  index = g_list_index (project->priv->undo_stack, cmd);
+  index = g_queue_index (&project->priv->undo_stack, cmd);
 
   do
     {
       next_cmd = glade_project_next_redo_item (project);
-      next_index = g_list_index (project->priv->undo_stack, next_cmd);
+      next_index = g_queue_index (&project->priv->undo_stack, next_cmd);
 
       glade_project_redo (project);
 
@@ -4846,7 +6066,7 @@ glade_project_redo_items (GladeProject *project)
 
   for (l = project->priv->prev_redo_item ?
        project->priv->prev_redo_item->next :
-       project->priv->undo_stack; l; l = walk_command (l, TRUE))
+       project->priv->undo_stack.head; l; l = walk_command (l, TRUE))
     {
       cmd = l->data;
 
@@ -5436,8 +6656,11 @@ _glade_project_emit_add_signal_handler (GladeWidget       *widget,
   GladeProject *project = glade_widget_get_project (widget);
 
   if (project)
-    g_signal_emit (project, glade_project_signals[ADD_SIGNAL_HANDLER], 0,
-                   widget, signal);
+    {
+      _glade_project_write_cache_invalidate (project, widget);
+      g_signal_emit (project, glade_project_signals[ADD_SIGNAL_HANDLER], 0,
+                     widget, signal);
+    }
 }
 
 void
@@ -5447,8 +6670,11 @@ _glade_project_emit_remove_signal_handler (GladeWidget       *widget,
   GladeProject *project = glade_widget_get_project (widget);
 
   if (project)
-    g_signal_emit (project, glade_project_signals[REMOVE_SIGNAL_HANDLER], 0,
-                   widget, signal);
+    {
+      _glade_project_write_cache_invalidate (project, widget);
+      g_signal_emit (project, glade_project_signals[REMOVE_SIGNAL_HANDLER], 0,
+                     widget, signal);
+    }
 
 }
 
@@ -5460,8 +6686,11 @@ _glade_project_emit_change_signal_handler (GladeWidget       *widget,
   GladeProject *project = glade_widget_get_project (widget);
 
   if (project)
-    g_signal_emit (project, glade_project_signals[CHANGE_SIGNAL_HANDLER], 0,
-                   widget, old_signal, new_signal);
+    {
+      _glade_project_write_cache_invalidate (project, widget);
+      g_signal_emit (project, glade_project_signals[CHANGE_SIGNAL_HANDLER], 0,
+                     widget, old_signal, new_signal);
+    }
 }
 
 void
@@ -5476,3 +6705,47 @@ _glade_project_emit_activate_signal_handler (GladeWidget       *widget,
 
 }
 
+/* Called whenever a property referencing @widget is added or removed,
+ * keeps the toplevels dependency graph up to date.
+ */
+void
+_glade_project_prop_refs_changed (GladeProject *project, GladeWidget *widget)
+{
+  GladeProjectPrivate *priv = project->priv;
+
+  if (!glade_project_has_gwidget (project, widget))
+    return;
+
+  if (glade_widget_has_prop_refs (widget))
+    g_hash_table_add (priv->referenced, widget);
+  else
+    g_hash_table_remove (priv->referenced, widget);
+
+  glade_project_invalidate_toplevels_order (project);
+}
+
+/* Drops the cached serialization of @widget's toplevel, or every cached
+ * toplevel if @widget is %NULL. Must be called for any change that modifies
+ * the output of glade_widget_write().
+ *
+ * The verification of @widget only depends on what is written, so it is
+ * dropped along with it.
+ */
+void
+_glade_project_write_cache_invalidate (GladeProject *project, GladeWidget *widget)
+{
+  GladeProjectPrivate *priv = project->priv;
+
+  if (widget == NULL)
+    {
+      g_hash_table_remove_all (priv->write_cache);
+      g_hash_table_remove_all (priv->verify_cache);
+      return;
+    }
+
+  g_hash_table_remove (priv->verify_cache, widget);
+
+  /* The widget might have been a toplevel itself until now */
+  g_hash_table_remove (priv->write_cache, widget);
+  g_hash_table_remove (priv->write_cache, glade_widget_get_toplevel (widget));
+}
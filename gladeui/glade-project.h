@@ -167,11 +167,15 @@ gboolean            glade_project_save_verify         (GladeProject        *proj
                                                        GError             **error);
 gboolean            glade_project_autosave            (GladeProject        *project,
                                                        GError             **error);
+void                glade_project_queue_autosave      (GladeProject        *project);
 gboolean            glade_project_backup              (GladeProject        *project,
                                                        const gchar         *path, 
                                                        GError             **error);
 void                glade_project_push_progress        (GladeProject       *project);
 gboolean            glade_project_load_cancelled       (GladeProject       *project);
+void                glade_project_queue_object_reference (GladeProject     *project,
+                                                          GladeProperty    *property,
+                                                          const gchar      *ids);
 void                glade_project_cancel_load          (GladeProject       *project);
 
 void                glade_project_preview              (GladeProject       *project, 
@@ -208,6 +212,13 @@ void                glade_project_push_undo            (GladeProject       *proj
                                                         GladeCommand       *cmd);
 GtkWidget          *glade_project_undo_items           (GladeProject       *project);
 GtkWidget          *glade_project_redo_items           (GladeProject       *project);
+void                glade_project_set_undo_limits      (GladeProject       *project,
+                                                        guint               max_commands,
+                                                        gsize               max_size);
+void                glade_project_set_undo_compaction  (GladeProject       *project,
+                                                        gboolean            compaction);
+gsize               glade_project_get_undo_size        (GladeProject       *project,
+                                                        guint              *n_commands);
 
 /* Add/Remove Objects */
 const GList        *glade_project_get_objects          (GladeProject       *project);
@@ -217,6 +228,8 @@ void                glade_project_remove_object        (GladeProject       *proj
                                                         GObject            *object);
 gboolean            glade_project_has_object           (GladeProject       *project,
                                                         GObject            *object);
+void                glade_project_begin_bulk_update    (GladeProject       *project);
+void                glade_project_end_bulk_update      (GladeProject       *project);
 void                glade_project_widget_changed       (GladeProject       *project,
                                                         GladeWidget        *gwidget);
 
@@ -245,6 +258,12 @@ void                glade_project_selection_add        (GladeProject       *proj
 void                glade_project_selection_remove     (GladeProject       *project,
                                                         GObject            *object,
                                                         gboolean            emit_signal);
+void                glade_project_selection_add_many   (GladeProject       *project,
+                                                        GList              *objects,
+                                                        gboolean            emit_signal);
+void                glade_project_selection_remove_many (GladeProject      *project,
+                                                        GList              *objects,
+                                                        gboolean            emit_signal);
 void                glade_project_selection_clear      (GladeProject       *project,
                                                         gboolean            emit_signal);
 void                glade_project_selection_changed    (GladeProject       *project);
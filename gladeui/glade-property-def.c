@@ -46,6 +46,7 @@
 #include "glade-editor-property.h"
 #include "glade-displayable-values.h"
 #include "glade-debug.h"
+#include "glade-private.h"
 
 #define NUMERICAL_STEP_INCREMENT   1.0F
 #define NUMERICAL_PAGE_INCREMENT   10.0F
@@ -189,6 +190,10 @@ struct _GladePropertyDef
                        * one from the object selection dialog, then set the name of the
                        * concrete type here.
                        */
+
+  gint ordinal;       /* Position of this property in its adaptor's property or packing
+                       * property list, assigned when the adaptor is registered, or -1
+                       */
 };
 
 G_DEFINE_BOXED_TYPE (GladePropertyDef, glade_property_def, glade_property_def_clone, glade_property_def_free)
@@ -236,6 +241,7 @@ glade_property_def_new (GladeWidgetAdaptor *adaptor,
   property_def->weight = -1.0;
   property_def->parentless_widget = FALSE;
   property_def->create_type = NULL;
+  property_def->ordinal = -1;
 
   /* Initialize property versions & deprecated to adaptor */
   property_def->version_since_major = GLADE_WIDGET_ADAPTOR_VERSION_SINCE_MAJOR (adaptor);
@@ -288,6 +294,9 @@ glade_property_def_clone (GladePropertyDef *property_def)
   if (property_def->create_type)
     clone->create_type = g_strdup (property_def->create_type);
 
+  /* The clone is not part of any adaptor yet */
+  clone->ordinal = -1;
+
   return clone;
 }
 
@@ -763,7 +772,7 @@ glade_property_def_make_object_from_string (GladePropertyDef *
       else
         fullpath = glade_project_resource_fullpath (project, string);
 
-      if ((pixbuf = gdk_pixbuf_new_from_file (fullpath, NULL)) == NULL)
+      if ((pixbuf = _glade_util_pixbuf_cache_load (fullpath)) == NULL)
         {
           GdkPixbuf *icon = gtk_icon_theme_load_icon (gtk_icon_theme_get_default (),
                                                       "image-missing", 22, 0, NULL);
@@ -1611,6 +1620,22 @@ _glade_property_def_reset_version (GladePropertyDef *property_def)
   property_def->deprecated_since_minor = 0;
 }
 
+void
+_glade_property_def_set_ordinal (GladePropertyDef *property_def, gint ordinal)
+{
+  g_return_if_fail (GLADE_IS_PROPERTY_DEF (property_def));
+
+  property_def->ordinal = ordinal;
+}
+
+gint
+_glade_property_def_get_ordinal (GladePropertyDef *property_def)
+{
+  g_return_val_if_fail (GLADE_IS_PROPERTY_DEF (property_def), -1);
+
+  return property_def->ordinal;
+}
+
 gboolean
 glade_property_def_deprecated (GladePropertyDef *property_def)
 {
@@ -54,6 +54,7 @@
 #include "glade-app.h"
 #include "glade-editor.h"
 #include "glade-marshallers.h"
+#include "glade-private.h"
 
 struct _GladePropertyPrivate {
 
@@ -201,6 +202,17 @@ glade_property_equals_value_impl (GladeProperty *property,
 }
 
 
+/* Any change to the serialized form of @property must call this */
+static void
+glade_property_invalidate_write_cache (GladeProperty *property)
+{
+  GladeProject *project;
+
+  if (property->priv->widget &&
+      (project = glade_widget_get_project (property->priv->widget)) != NULL)
+    _glade_project_write_cache_invalidate (project, property->priv->widget);
+}
+
 static void
 glade_property_update_prop_refs (GladeProperty *property,
                                  const GValue  *old_value,
@@ -394,6 +406,8 @@ glade_property_set_value_impl (GladeProperty *property, const GValue *value)
 
   if (changed && property->priv->widget)
     {
+      glade_property_invalidate_write_cache (property);
+
       g_signal_emit (G_OBJECT (property),
                      glade_property_signals[VALUE_CHANGED],
                      0, &old_value, property->priv->value);
@@ -1115,6 +1129,7 @@ glade_property_load (GladeProperty *property)
 {
   g_return_if_fail (GLADE_IS_PROPERTY (property));
   GLADE_PROPERTY_GET_CLASS (property)->load (property);
+  glade_property_invalidate_write_cache (property);
 }
 
 /**
@@ -1162,8 +1177,7 @@ glade_property_read (GladeProperty *property,
        * (i.e. lookup the actual objects after they've been parsed and
        * are present).
        */
-      g_object_set_data_full (G_OBJECT (property),
-                              "glade-loaded-object", g_strdup (value), g_free);
+      glade_project_queue_object_reference (project, property, value);
     }
   else
     {
@@ -1433,6 +1447,7 @@ glade_property_i18n_set_comment (GladeProperty *property, const gchar *str)
     g_free (property->priv->i18n_comment);
 
   property->priv->i18n_comment = g_strdup (str);
+  glade_property_invalidate_write_cache (property);
   g_object_notify_by_pspec (G_OBJECT (property), properties[PROP_I18N_COMMENT]);
 }
 
@@ -1451,6 +1466,7 @@ glade_property_i18n_set_context (GladeProperty *property, const gchar *str)
     g_free (property->priv->i18n_context);
 
   property->priv->i18n_context = g_strdup (str);
+  glade_property_invalidate_write_cache (property);
   g_object_notify_by_pspec (G_OBJECT (property), properties[PROP_I18N_CONTEXT]);
 }
 
@@ -1467,6 +1483,7 @@ glade_property_i18n_set_translatable (GladeProperty *property,
 {
   g_return_if_fail (GLADE_IS_PROPERTY (property));
   property->priv->i18n_translatable = translatable;
+  glade_property_invalidate_write_cache (property);
   g_object_notify_by_pspec (G_OBJECT (property), properties[PROP_I18N_TRANSLATABLE]);
 }
 
@@ -1597,6 +1614,7 @@ glade_property_set_save_always (GladeProperty *property, gboolean setting)
   g_return_if_fail (GLADE_IS_PROPERTY (property));
 
   property->priv->save_always = setting;
+  glade_property_invalidate_write_cache (property);
 }
 
 /**
@@ -1626,6 +1644,7 @@ glade_property_set_enabled (GladeProperty *property, gboolean enabled)
 
   property->priv->enabled = enabled;
   glade_property_sync (property);
+  glade_property_invalidate_write_cache (property);
 
   glade_property_fix_state (property);
 
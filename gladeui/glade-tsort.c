@@ -59,33 +59,34 @@ _node_edge_list_free (GList *list)
   g_list_free_full (list, _node_edge_free);
 }
 
-static inline void
-tsort_remove_non_start_nodes (GList **nodes, GList *edges)
+typedef struct
 {
-  GList *l;
+  GSList   *outgoing;  /* Edges with this node as predecessor, in reverse order */
+  guint     indegree;  /* Number of edges with this node as successor left in the graph */
+  gboolean  sorted;    /* Whether this node was already inserted in the sorted list */
+} _NodeInfo;
 
-  for (l = edges; l; l = g_list_next (l))
-    {
-      _NodeEdge *edge = l->data;
-      *nodes = g_list_remove (*nodes, edge->successor);
-    }
-}
+static void
+_node_info_free (gpointer data)
+{
+  _NodeInfo *info = data;
 
+  g_slist_free (info->outgoing);
+  g_slice_free (_NodeInfo, info);
+}
 
-static inline gboolean
-tsort_node_has_no_incoming_edge (gpointer node, GList *edges)
+static inline _NodeInfo *
+tsort_node_info_ensure (GHashTable *graph, gpointer node)
 {
-  GList *l;
+  _NodeInfo *info = g_hash_table_lookup (graph, node);
 
-  for (l = edges; l; l = g_list_next (l))
+  if (info == NULL)
     {
-      _NodeEdge *edge = l->data;
-
-      if (node == edge->successor)
-        return FALSE;
+      info = g_slice_new0 (_NodeInfo);
+      g_hash_table_insert (graph, node, info);
     }
 
-  return TRUE;
+  return info;
 }
 
 /**
@@ -118,51 +119,99 @@ tsort_node_has_no_incoming_edge (gpointer node, GList *edges)
 GList *
 _glade_tsort (GList **nodes, GList **edges)
 {
-  GList *sorted_nodes;
+  GList *sorted_nodes, *l, *next;
+  GHashTable *graph;
+  GPtrArray *start_nodes;
+
+  /* Build adjacency lists and indegree counters, every edge removal from
+   * the graph is then a counter decrement instead of a list scan.
+   */
+  graph = g_hash_table_new_full (NULL, NULL, NULL, _node_info_free);
+
+  for (l = *edges; l; l = g_list_next (l))
+    {
+      _NodeEdge *edge = l->data;
+      _NodeInfo *info;
+
+      info = tsort_node_info_ensure (graph, edge->predecessor);
+      info->outgoing = g_slist_prepend (info->outgoing, edge);
+
+      info = tsort_node_info_ensure (graph, edge->successor);
+      info->indegree++;
+    }
 
   /* L ← Empty list that will contain the sorted elements */
   sorted_nodes = NULL;
 
-  /* S ← Set of all nodes with no incoming edges */
-  tsort_remove_non_start_nodes (nodes, *edges);
+  /* S ← Set of all nodes with no incoming edges
+   *
+   * S is used as a stack, the top is the end of the array. Nodes are pushed
+   * in reverse order so that they are removed in the same order as @nodes.
+   */
+  start_nodes = g_ptr_array_new ();
+
+  for (l = g_list_last (*nodes); l; l = g_list_previous (l))
+    {
+      _NodeInfo *info = g_hash_table_lookup (graph, l->data);
+
+      if (info == NULL || info->indegree == 0)
+        g_ptr_array_add (start_nodes, l->data);
+    }
+
+  g_list_free (*nodes);
+  *nodes = NULL;
 
   /* while S is non-empty do */
-  while (*nodes)
+  while (start_nodes->len)
     {
-      GList *l, *next;
+      _NodeInfo *info;
+      GSList *ll;
       gpointer n;
 
       /* remove a node n from S */
-      n = (*nodes)->data;
-      *nodes = g_list_delete_link (*nodes, *nodes);
+      n = g_ptr_array_remove_index (start_nodes, start_nodes->len - 1);
 
       /* insert n into L */
-      /*if (!glade_widget_get_parent (n)) this would be a specific optimization */
       sorted_nodes = g_list_prepend (sorted_nodes, n);
 
-      /* for each node m ... */
-      for (l = *edges; l; l = next)
+      if ((info = g_hash_table_lookup (graph, n)) == NULL || info->sorted)
+        continue;
+
+      info->sorted = TRUE;
+      info->outgoing = g_slist_reverse (info->outgoing);
+
+      /* for each node m with an edge e from n to m do */
+      for (ll = info->outgoing; ll; ll = g_slist_next (ll))
+        {
+          _NodeEdge *edge = ll->data;
+          _NodeInfo *successor = g_hash_table_lookup (graph, edge->successor);
+
+          /* remove edge e from the graph,
+           * if m has no other incoming edges then insert m into S
+           */
+          if (--successor->indegree == 0)
+            g_ptr_array_add (start_nodes, edge->successor);
+        }
+    }
+
+  /* Leave only the edges that were not removed from the graph */
+  for (l = *edges; l; l = next)
+    {
+      _NodeEdge *edge = l->data;
+      _NodeInfo *info = g_hash_table_lookup (graph, edge->predecessor);
+
+      next = g_list_next (l);
+
+      if (info->sorted)
         {
-          _NodeEdge *edge = l->data;
-
-          next = g_list_next (l);
-
-          /* ... with an edge e from n to m do */
-          if (edge->predecessor == n)
-            {
-              /* remove edge e from the graph */
-              *edges = g_list_delete_link (*edges, l);
-
-              /* if m has no other incoming edges then */
-              if (tsort_node_has_no_incoming_edge (edge->successor, *edges))
-                /* insert m into S */
-                *nodes = g_list_prepend (*nodes, edge->successor);
-              
-              g_slice_free (_NodeEdge, edge);
-            }
+          *edges = g_list_delete_link (*edges, l);
+          _node_edge_free (edge);
         }
     }
 
+  g_ptr_array_free (start_nodes, TRUE);
+  g_hash_table_destroy (graph);
+
   /* if graph has edges then return error (graph has at least one cycle) */
 #if 0   /* We rather not return NULL, caller must check if edge */
   if (*edges)
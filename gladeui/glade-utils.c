@@ -124,6 +124,10 @@ glade_util_get_type_from_name (const gchar *name, gboolean have_func)
       g_once_init_leave (&allsymbols, symbols);
     }
 
+  /* Types from a catalog which is not loaded yet only exist once it is */
+  if (!have_func && g_type_from_name (name) == 0)
+    _glade_catalog_load_deferred_class (name);
+
   if ((type = g_type_from_name (name)) == 0 &&
       (have_func ||
        (func_name = _glade_util_compose_get_type_func (name)) != NULL))
@@ -190,6 +194,27 @@ _glade_util_dialog_set_hig (GtkDialog *dialog)
   gtk_box_set_spacing (GTK_BOX (action_area), 6);
 }
 
+/* Answers glade_util_ui_message() instead of a dialog, see
+ * _glade_util_set_ui_message_func()
+ */
+static GladeUIMessageFunc ui_message_func = NULL;
+static gpointer ui_message_data = NULL;
+
+/**
+ * _glade_util_set_ui_message_func:
+ * @func: (nullable): the function answering messages, or %NULL to use dialogs
+ * @user_data: data for @func
+ *
+ * Makes glade_util_ui_message() pass messages to @func instead of running
+ * a dialog, for programs without a user to answer them.
+ */
+void
+_glade_util_set_ui_message_func (GladeUIMessageFunc func, gpointer user_data)
+{
+  ui_message_func = func;
+  ui_message_data = user_data;
+}
+
 static void
 glade_util_ui_message_foreach (GtkWidget *widget, gpointer data)
 {
@@ -231,6 +256,21 @@ glade_util_ui_message (GtkWidget *parent,
   string = g_strdup_vprintf (format, args);
   va_end (args);
 
+  if (ui_message_func)
+    {
+      response = ui_message_func (type, string, ui_message_data);
+
+      if (widget)
+        {
+          g_object_ref_sink (widget);
+          gtk_widget_destroy (widget);
+          g_object_unref (widget);
+        }
+
+      g_free (string);
+      return response;
+    }
+
   /* Get message_type */
   switch (type)
     {
@@ -2195,3 +2235,126 @@ _glade_util_file_get_relative_path (GFile *target, GFile *source)
 
   return relative_path;
 }
+
+/* Decoded images shared by the pixbuf properties of all projects, images
+ * are reloaded when their file changes and the least recently used ones
+ * are dropped once the cache holds more than PIXBUF_CACHE_MAX_SIZE bytes.
+ */
+#define PIXBUF_CACHE_MAX_SIZE (64 * 1024 * 1024)
+
+typedef struct
+{
+  gchar     *path;
+  GdkPixbuf *pixbuf;
+  gint64     mtime;
+  goffset    size;
+  gsize      bytes;
+  GList      link;     /* Link in the LRU queue, most recently used first */
+} PixbufCacheEntry;
+
+static GHashTable *pixbuf_cache = NULL;
+static GQueue      pixbuf_cache_lru = G_QUEUE_INIT;
+static gsize       pixbuf_cache_bytes = 0;
+static guint       pixbuf_cache_hits = 0;
+static guint       pixbuf_cache_misses = 0;
+
+static void
+pixbuf_cache_entry_free (PixbufCacheEntry *entry)
+{
+  g_queue_unlink (&pixbuf_cache_lru, &entry->link);
+  pixbuf_cache_bytes -= entry->bytes;
+
+  g_object_unref (entry->pixbuf);
+  g_free (entry->path);
+  g_slice_free (PixbufCacheEntry, entry);
+}
+
+/**
+ * _glade_util_pixbuf_cache_load:
+ * @path: the full path of an image file
+ *
+ * Loads the image at @path, decoding it only if it was not decoded before
+ * or if the file changed since. Every call returns a distinct #GdkPixbuf
+ * sharing the cached pixels, so data can be attached to it per reference.
+ *
+ * Returns: (transfer full) (nullable): a new #GdkPixbuf, or %NULL if
+ * @path could not be loaded.
+ */
+GdkPixbuf *
+_glade_util_pixbuf_cache_load (const gchar *path)
+{
+  PixbufCacheEntry *entry;
+  GdkPixbuf *pixbuf;
+  GStatBuf stat_buf;
+
+  g_return_val_if_fail (path != NULL, NULL);
+
+  if (pixbuf_cache == NULL)
+    pixbuf_cache = g_hash_table_new_full (g_str_hash, g_str_equal, NULL,
+                                          (GDestroyNotify) pixbuf_cache_entry_free);
+
+  if (g_stat (path, &stat_buf) != 0)
+    {
+      g_hash_table_remove (pixbuf_cache, path);
+      return NULL;
+    }
+
+  entry = g_hash_table_lookup (pixbuf_cache, path);
+
+  if (entry && entry->mtime == stat_buf.st_mtime && entry->size == stat_buf.st_size)
+    {
+      pixbuf_cache_hits++;
+
+      /* Move it to the front of the LRU queue */
+      g_queue_unlink (&pixbuf_cache_lru, &entry->link);
+      g_queue_push_head_link (&pixbuf_cache_lru, &entry->link);
+    }
+  else
+    {
+      pixbuf_cache_misses++;
+
+      if (entry)
+        g_hash_table_remove (pixbuf_cache, path);
+
+      if ((pixbuf = gdk_pixbuf_new_from_file (path, NULL)) == NULL)
+        return NULL;
+
+      entry = g_slice_new0 (PixbufCacheEntry);
+      entry->path = g_strdup (path);
+      entry->pixbuf = pixbuf;
+      entry->mtime = stat_buf.st_mtime;
+      entry->size = stat_buf.st_size;
+      entry->bytes = gdk_pixbuf_get_byte_length (pixbuf);
+      entry->link.data = entry;
+
+      g_hash_table_insert (pixbuf_cache, entry->path, entry);
+      g_queue_push_head_link (&pixbuf_cache_lru, &entry->link);
+      pixbuf_cache_bytes += entry->bytes;
+
+      /* Evict the least recently used images, but never the new one */
+      while (pixbuf_cache_bytes > PIXBUF_CACHE_MAX_SIZE &&
+             pixbuf_cache_lru.tail != &entry->link)
+        {
+          PixbufCacheEntry *last = pixbuf_cache_lru.tail->data;
+
+          g_hash_table_remove (pixbuf_cache, last->path);
+        }
+    }
+
+  GLADE_NOTE (IMAGES,
+              g_print ("IMAGES: %s (%u hits, %u misses, %" G_GSIZE_FORMAT " bytes cached)\n",
+                       path, pixbuf_cache_hits, pixbuf_cache_misses, pixbuf_cache_bytes));
+
+  return gdk_pixbuf_new_subpixbuf (entry->pixbuf, 0, 0,
+                                   gdk_pixbuf_get_width (entry->pixbuf),
+                                   gdk_pixbuf_get_height (entry->pixbuf));
+}
+
+void
+_glade_util_pixbuf_cache_get_stats (guint *hits, guint *misses)
+{
+  if (hits)
+    *hits = pixbuf_cache_hits;
+  if (misses)
+    *misses = pixbuf_cache_misses;
+}
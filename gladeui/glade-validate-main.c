@@ -0,0 +1,809 @@
+/*
+ * Copyright (C) 2026 The Glade developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation; either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+
+#include <gladeui/glade.h>
+#include <gladeui/glade-private.h>
+
+#include <stdio.h>
+#include <string.h>
+#include <locale.h>
+#include <glib/gi18n-lib.h>
+#include <glib/gstdio.h>
+
+#ifdef G_OS_WIN32
+#include <io.h>
+#else
+#include <signal.h>
+#include <unistd.h>
+#endif
+
+typedef enum
+{
+  FILE_OK,
+  FILE_PROBLEMS,
+  FILE_ERROR,
+  N_FILE_STATUS
+} FileStatus;
+
+static const gchar *file_status_names[N_FILE_STATUS] = { "ok", "problems", "error" };
+
+/* Reports are written in file order, as soon as every previous file is done */
+typedef struct
+{
+  gchar **files;
+  guint n_files;
+  guint next_file;              /* Next file to hand out to a worker  */
+  guint next_report;            /* Next report to write               */
+  guint n_done;
+
+  gchar **reports;              /* One JSON object per file, by index */
+  guint counts[N_FILE_STATUS];
+  FILE *report_file;
+
+  gchar **argv;                 /* Worker command line                */
+  GList *workers;
+  GMainLoop *loop;
+} Pool;
+
+typedef struct
+{
+  Pool *pool;
+  GSubprocess *process;
+  GDataInputStream *output;     /* Reports from the worker            */
+  GOutputStream *input;         /* File names for the worker          */
+  gint current;                 /* File being validated, or -1        */
+} Worker;
+
+static gint jobs = 0;
+static gboolean save = FALSE;
+static gboolean force = FALSE;
+static gboolean worker_mode = FALSE;
+static FILE *worker_channel = NULL;
+static gboolean version = FALSE;
+static gchar *verify_names = NULL;
+static gchar *report_file_name = NULL;
+static gchar **file_names = NULL;
+
+static GladeVerifyFlags verify_flags = GLADE_VERIFY_VERSIONS | GLADE_VERIFY_UNRECOGNIZED;
+
+/* What is being done with the current file, messages are only collected
+ * while this is set.
+ */
+static const gchar *current_stage = NULL;
+
+/* Comma separated JSON objects for the current file */
+static GString *diagnostics = NULL;
+
+static void
+json_append_string (GString *json, const gchar *string)
+{
+  const gchar *p;
+
+  g_string_append_c (json, '"');
+
+  for (p = string; *p; p++)
+    {
+      switch (*p)
+        {
+          case '"':
+            g_string_append (json, "\\\"");
+            break;
+          case '\\':
+            g_string_append (json, "\\\\");
+            break;
+          case '\n':
+            g_string_append (json, "\\n");
+            break;
+          case '\t':
+            g_string_append (json, "\\t");
+            break;
+          default:
+            if ((guchar) *p < 0x20)
+              g_string_append_printf (json, "\\u%04x", (guchar) *p);
+            else
+              g_string_append_c (json, *p);
+            break;
+        }
+    }
+
+  g_string_append_c (json, '"');
+}
+
+/* Seconds are always written with a dot, whatever the locale */
+static void
+json_append_seconds (GString *json, const gchar *member, gint64 usecs)
+{
+  gchar buffer[G_ASCII_DTOSTR_BUF_SIZE];
+
+  g_string_append_printf (json, ",\"%s\":%s", member,
+                          g_ascii_formatd (buffer, sizeof (buffer), "%.6f",
+                                           usecs / (gdouble) G_USEC_PER_SEC));
+}
+
+static void
+diagnostics_add (const gchar *source, const gchar *object, const gchar *message)
+{
+  if (diagnostics->len > 0)
+    g_string_append_c (diagnostics, ',');
+
+  g_string_append (diagnostics, "{\"source\":");
+  json_append_string (diagnostics, source);
+
+  if (object)
+    {
+      g_string_append (diagnostics, ",\"object\":");
+      json_append_string (diagnostics, object);
+    }
+
+  g_string_append (diagnostics, ",\"message\":");
+  json_append_string (diagnostics, message);
+  g_string_append_c (diagnostics, '}');
+}
+
+static gchar *
+strip_markup (const gchar *markup)
+{
+  gchar *text = NULL;
+
+  if (!pango_parse_markup (markup, -1, 0, NULL, &text, NULL, NULL))
+    text = g_strdup (markup);
+
+  return text;
+}
+
+/* Verify messages are made of "[object]" lines followed by one
+ * tab indented line per problem, or of single line problems.
+ */
+static void
+diagnostics_add_verify (const gchar *markup)
+{
+  gchar *text = strip_markup (markup);
+  gchar **lines = g_strsplit (text, "\n", -1);
+  const gchar *object = NULL;
+  guint i;
+
+  for (i = 0; lines[i]; i++)
+    {
+      gchar *line = lines[i];
+      gsize len = strlen (line);
+
+      if (line[0] == '\t')
+        diagnostics_add (current_stage, object, line + 1);
+      else if (len > 2 && line[0] == '[' && line[len - 1] == ']')
+        {
+          line[len - 1] = '\0';
+          object = line + 1;
+        }
+      else if (len > 0)
+        {
+          diagnostics_add (current_stage, NULL, line);
+          object = NULL;
+        }
+    }
+
+  g_strfreev (lines);
+  g_free (text);
+}
+
+/* Messages Glade would show in a dialog, they are always answered with no */
+static gboolean
+on_ui_message (GladeUIMessageType type, const gchar *message, gpointer user_data)
+{
+  gchar *text = strip_markup (message);
+
+  if (current_stage)
+    diagnostics_add (current_stage, NULL, text);
+  else
+    g_printerr ("%s\n", text);
+
+  g_free (text);
+
+  return FALSE;
+}
+
+static void
+on_log_message (const gchar   *log_domain,
+                GLogLevelFlags log_level,
+                const gchar   *message,
+                gpointer       user_data)
+{
+  if (current_stage)
+    diagnostics_add (current_stage, NULL, message);
+  else
+    g_log_default_handler (log_domain, log_level, message, user_data);
+}
+
+/* Keeps the standard output of a worker as its channel back to the
+ * parent and sends everything else printed there to standard error, a
+ * stray message from a plugin would otherwise look like a broken report.
+ */
+static gboolean
+worker_open_channel (void)
+{
+  gint fd;
+
+  fflush (stdout);
+
+  if ((fd = dup (fileno (stdout))) < 0)
+    return FALSE;
+
+  if (dup2 (fileno (stderr), fileno (stdout)) < 0 ||
+      !(worker_channel = fdopen (fd, "w")))
+    {
+      close (fd);
+      return FALSE;
+    }
+
+  return TRUE;
+}
+
+static gchar *
+report_new (const gchar *filename,
+            FileStatus   status,
+            gint64       load_time,
+            gint64       verify_time,
+            gint64       save_time,
+            const gchar *diagnostics_json)
+{
+  GString *json = g_string_new ("{\"file\":");
+  gchar *display_name = g_filename_display_name (filename);
+
+  json_append_string (json, display_name);
+  g_string_append (json, ",\"status\":");
+  json_append_string (json, file_status_names[status]);
+  json_append_seconds (json, "load", load_time);
+  json_append_seconds (json, "verify", verify_time);
+  json_append_seconds (json, "save", save_time);
+  g_string_append_printf (json, ",\"diagnostics\":[%s]}", diagnostics_json);
+
+  g_free (display_name);
+
+  return g_string_free (json, FALSE);
+}
+
+/* Loads @filename, verifies it and saves it back if requested */
+static gchar *
+validate_file (const gchar *filename, FileStatus *status)
+{
+  gint64 start, load_time, verify_time = 0, save_time = 0;
+  GladeProject *project;
+  gchar *report;
+
+  diagnostics = g_string_new (NULL);
+  *status = FILE_OK;
+
+  current_stage = "load";
+  start = g_get_monotonic_time ();
+  project = glade_project_load (filename);
+  load_time = g_get_monotonic_time () - start;
+
+  if (project)
+    {
+      gchar *message;
+
+      current_stage = "verify";
+      start = g_get_monotonic_time ();
+      message = _glade_project_verify_message (project, verify_flags);
+      verify_time = g_get_monotonic_time () - start;
+
+      if (message)
+        diagnostics_add_verify (message);
+
+      if (save && (!message || force))
+        {
+          GError *error = NULL;
+
+          current_stage = "save";
+          start = g_get_monotonic_time ();
+
+          if (!glade_project_save_verify (project, glade_project_get_path (project),
+                                          force ? 0 : verify_flags, &error))
+            {
+              diagnostics_add (current_stage, NULL,
+                               error ? error->message : _("The file was not saved"));
+              *status = FILE_ERROR;
+              g_clear_error (&error);
+            }
+
+          save_time = g_get_monotonic_time () - start;
+        }
+
+      g_free (message);
+      g_object_unref (project);
+    }
+  else
+    {
+      if (diagnostics->len == 0)
+        diagnostics_add (current_stage, NULL, _("The file could not be loaded"));
+
+      *status = FILE_ERROR;
+    }
+
+  current_stage = NULL;
+
+  /* Let the project widgets go before the next file */
+  while (gtk_events_pending ())
+    gtk_main_iteration ();
+
+  if (*status == FILE_OK && diagnostics->len > 0)
+    *status = FILE_PROBLEMS;
+
+  report = report_new (filename, *status, load_time, verify_time, save_time,
+                       diagnostics->str);
+  g_string_free (diagnostics, TRUE);
+  diagnostics = NULL;
+
+  return report;
+}
+
+static gboolean
+init_glade (gint *argc, gchar ***argv)
+{
+  if (!gtk_init_check (argc, argv))
+    {
+      g_printerr (_("Could not initialize GTK+, make sure a display is available.\n"));
+      return FALSE;
+    }
+
+  glade_app_get ();
+
+  _glade_util_set_ui_message_func (on_ui_message, NULL);
+  g_log_set_handler ("GladeUI",
+                     G_LOG_LEVEL_WARNING | G_LOG_LEVEL_CRITICAL | G_LOG_LEVEL_MESSAGE,
+                     on_log_message, NULL);
+
+  return TRUE;
+}
+
+/* Validates the files named in standard input, one per line, and writes
+ * back "<status> <report>" lines to the parent.
+ */
+static gint
+run_worker (void)
+{
+#ifdef G_OS_WIN32
+  GIOChannel *input = g_io_channel_win32_new_fd (fileno (stdin));
+#else
+  GIOChannel *input = g_io_channel_unix_new (fileno (stdin));
+#endif
+  gsize terminator_pos;
+  gchar *line;
+
+  g_io_channel_set_encoding (input, NULL, NULL);
+
+  while (g_io_channel_read_line (input, &line, NULL, &terminator_pos, NULL) == G_IO_STATUS_NORMAL)
+    {
+      FileStatus status;
+      gchar *report;
+
+      line[terminator_pos] = '\0';
+      report = validate_file (line, &status);
+
+      fprintf (worker_channel, "%d %s\n", status, report);
+      fflush (worker_channel);
+
+      g_free (report);
+      g_free (line);
+    }
+
+  g_io_channel_unref (input);
+  fclose (worker_channel);
+
+  return 0;
+}
+
+static Pool *
+pool_new (gchar **files, FILE *report_file)
+{
+  Pool *pool = g_new0 (Pool, 1);
+
+  pool->files = files;
+  pool->n_files = g_strv_length (files);
+  pool->reports = g_new0 (gchar *, pool->n_files);
+  pool->report_file = report_file;
+
+  return pool;
+}
+
+static void
+pool_free (Pool *pool)
+{
+  g_strfreev (pool->argv);
+  g_free (pool->reports);
+  g_clear_pointer (&pool->loop, g_main_loop_unref);
+  g_free (pool);
+}
+
+static void
+pool_add_report (Pool *pool, guint index, FileStatus status, gchar *report)
+{
+  pool->reports[index] = report;
+  pool->counts[status]++;
+  pool->n_done++;
+
+  while (pool->next_report < pool->n_files && pool->reports[pool->next_report])
+    {
+      fprintf (pool->report_file, "%s\n", pool->reports[pool->next_report]);
+      g_clear_pointer (&pool->reports[pool->next_report], g_free);
+      pool->next_report++;
+    }
+
+  fflush (pool->report_file);
+
+  if (pool->n_done == pool->n_files && pool->loop)
+    g_main_loop_quit (pool->loop);
+}
+
+static void
+pool_add_error (Pool *pool, guint index, const gchar *message)
+{
+  GString *json = g_string_new ("{\"source\":\"worker\",\"message\":");
+  gchar *report;
+
+  json_append_string (json, message);
+  g_string_append_c (json, '}');
+
+  report = report_new (pool->files[index], FILE_ERROR, 0, 0, 0, json->str);
+  pool_add_report (pool, index, FILE_ERROR, report);
+
+  g_string_free (json, TRUE);
+}
+
+static void
+pool_run_in_process (Pool *pool)
+{
+  guint i;
+
+  for (i = 0; i < pool->n_files; i++)
+    {
+      FileStatus status;
+      gchar *report = validate_file (pool->files[i], &status);
+
+      pool_add_report (pool, i, status, report);
+    }
+}
+
+static gboolean pool_spawn_worker (Pool *pool);
+
+static void
+worker_free (Worker *worker)
+{
+  g_object_unref (worker->output);
+  g_object_unref (worker->process);
+  g_slice_free (Worker, worker);
+}
+
+static void on_worker_report (GObject *source, GAsyncResult *result, gpointer data);
+
+/* Hands out the next file to @worker, or lets it exit if there are none */
+static void
+worker_dispatch (Worker *worker)
+{
+  Pool *pool = worker->pool;
+  gchar *line;
+
+  if (pool->next_file >= pool->n_files)
+    {
+      worker->current = -1;
+      g_output_stream_close (worker->input, NULL, NULL);
+      return;
+    }
+
+  worker->current = pool->next_file++;
+  line = g_strconcat (pool->files[worker->current], "\n", NULL);
+
+  /* A worker which is gone fails the read below as well */
+  g_output_stream_write_all (worker->input, line, strlen (line), NULL, NULL, NULL);
+  g_output_stream_flush (worker->input, NULL, NULL);
+  g_free (line);
+
+  g_data_input_stream_read_line_async (worker->output, G_PRIORITY_DEFAULT, NULL,
+                                       on_worker_report, worker);
+}
+
+static void
+on_worker_report (GObject *source, GAsyncResult *result, gpointer data)
+{
+  Worker *worker = data;
+  Pool *pool = worker->pool;
+  gchar *line, *report;
+  guint64 status;
+
+  line = g_data_input_stream_read_line_finish (worker->output, result, NULL, NULL);
+
+  if (line && (report = strchr (line, ' ')))
+    *report++ = '\0';
+  else
+    report = NULL;
+
+  if (report && g_ascii_string_to_unsigned (line, 10, 0, N_FILE_STATUS - 1, &status, NULL))
+    {
+      pool_add_report (pool, worker->current, status, g_strdup (report));
+      g_free (line);
+      worker_dispatch (worker);
+      return;
+    }
+
+  /* The worker crashed or exited on its own, its file failed and
+   * another worker takes over the remaining ones.
+   */
+  g_free (line);
+  pool_add_error (pool, worker->current, _("The worker process exited unexpectedly"));
+
+  g_subprocess_force_exit (worker->process);
+  pool->workers = g_list_remove (pool->workers, worker);
+  worker_free (worker);
+
+  if (pool->next_file < pool->n_files && !pool_spawn_worker (pool) && !pool->workers)
+    {
+      while (pool->next_file < pool->n_files)
+        pool_add_error (pool, pool->next_file++, _("Could not start a worker process"));
+    }
+}
+
+static gboolean
+pool_spawn_worker (Pool *pool)
+{
+  GError *error = NULL;
+  GSubprocess *process;
+  Worker *worker;
+
+  process = g_subprocess_newv ((const gchar * const *) pool->argv,
+                               G_SUBPROCESS_FLAGS_STDIN_PIPE |
+                               G_SUBPROCESS_FLAGS_STDOUT_PIPE,
+                               &error);
+  if (!process)
+    {
+      g_printerr (_("Could not start a worker process: %s\n"), error->message);
+      g_error_free (error);
+      return FALSE;
+    }
+
+  worker = g_slice_new0 (Worker);
+  worker->pool = pool;
+  worker->process = process;
+  worker->input = g_subprocess_get_stdin_pipe (process);
+  worker->output = g_data_input_stream_new (g_subprocess_get_stdout_pipe (process));
+
+  pool->workers = g_list_prepend (pool->workers, worker);
+  worker_dispatch (worker);
+
+  return TRUE;
+}
+
+/* Spreads the files over @n_workers processes running this same program
+ * in worker mode, returns FALSE if none could be started.
+ */
+static gboolean
+pool_run (Pool *pool, const gchar *program, gint n_workers)
+{
+  GPtrArray *argv = g_ptr_array_new ();
+  GList *l;
+  gint i;
+
+  g_ptr_array_add (argv, g_strdup (program));
+  g_ptr_array_add (argv, g_strdup ("--worker"));
+
+  if (verify_names)
+    g_ptr_array_add (argv, g_strconcat ("--verify=", verify_names, NULL));
+  if (save)
+    g_ptr_array_add (argv, g_strdup ("--save"));
+  if (force)
+    g_ptr_array_add (argv, g_strdup ("--force"));
+
+  g_ptr_array_add (argv, NULL);
+  pool->argv = (gchar **) g_ptr_array_free (argv, FALSE);
+
+#ifndef G_OS_WIN32
+  /* Writing to a crashed worker must not take us down with it */
+  signal (SIGPIPE, SIG_IGN);
+#endif
+
+  for (i = 0; i < n_workers; i++)
+    pool_spawn_worker (pool);
+
+  if (!pool->workers)
+    return FALSE;
+
+  pool->loop = g_main_loop_new (NULL, FALSE);
+
+  if (pool->n_done < pool->n_files)
+    g_main_loop_run (pool->loop);
+
+  /* Every worker got its input closed by now */
+  for (l = pool->workers; l; l = g_list_next (l))
+    {
+      Worker *worker = l->data;
+
+      g_subprocess_wait (worker->process, NULL, NULL);
+      worker_free (worker);
+    }
+
+  g_clear_pointer (&pool->workers, g_list_free);
+
+  return TRUE;
+}
+
+static gchar *
+get_program_path (const gchar *argv0)
+{
+  if (g_path_is_absolute (argv0) || strchr (argv0, G_DIR_SEPARATOR))
+    return g_strdup (argv0);
+
+  return g_find_program_in_path (argv0);
+}
+
+static gboolean
+parse_verify_flags (const gchar *names, GError **error)
+{
+  gchar **tokens = g_strsplit (names, ",", -1);
+  gboolean retval = TRUE;
+  guint i;
+
+  verify_flags = 0;
+
+  for (i = 0; tokens[i]; i++)
+    {
+      g_strstrip (tokens[i]);
+
+      if (g_strcmp0 (tokens[i], "versions") == 0)
+        verify_flags |= GLADE_VERIFY_VERSIONS;
+      else if (g_strcmp0 (tokens[i], "deprecations") == 0)
+        verify_flags |= GLADE_VERIFY_DEPRECATIONS;
+      else if (g_strcmp0 (tokens[i], "unrecognized") == 0)
+        verify_flags |= GLADE_VERIFY_UNRECOGNIZED;
+      else if (g_strcmp0 (tokens[i], "none") != 0)
+        {
+          g_set_error (error, G_OPTION_ERROR, G_OPTION_ERROR_BAD_VALUE,
+                       _("Unknown verification '%s'"), tokens[i]);
+          retval = FALSE;
+          break;
+        }
+    }
+
+  g_strfreev (tokens);
+
+  return retval;
+}
+
+static GOptionEntry option_entries[] =
+{
+    {"jobs", 'j', 0, G_OPTION_ARG_INT, &jobs, N_("Number of files validated in parallel, defaults to the number of processors"), "N"},
+    {"verify", 0, 0, G_OPTION_ARG_STRING, &verify_names, N_("Comma separated checks: versions, deprecations, unrecognized or none"), "CHECKS"},
+    {"save", 0, 0, G_OPTION_ARG_NONE, &save, N_("Save files back when no problems are found"), NULL},
+    {"force", 0, 0, G_OPTION_ARG_NONE, &force, N_("Save files back even if problems are found"), NULL},
+    {"report", 'r', 0, G_OPTION_ARG_FILENAME, &report_file_name, N_("File to write the report to, defaults to standard output"), "FILENAME"},
+    {"worker", 0, G_OPTION_FLAG_HIDDEN, G_OPTION_ARG_NONE, &worker_mode, NULL, NULL},
+    {"version", 'v', 0, G_OPTION_ARG_NONE, &version, N_("Display version"), NULL},
+    {G_OPTION_REMAINING, 0, 0, G_OPTION_ARG_FILENAME_ARRAY, &file_names, NULL, N_("FILE…")},
+    {NULL}
+};
+
+int
+main (int argc, char **argv)
+{
+  gchar buffer[G_ASCII_DTOSTR_BUF_SIZE];
+  GOptionContext *context;
+  GError *error = NULL;
+  gchar *program = NULL;
+  FILE *report_file;
+  gint64 start;
+  Pool *pool;
+  gint retval;
+
+#ifdef ENABLE_NLS
+  setlocale (LC_ALL, "");
+  bindtextdomain (GETTEXT_PACKAGE, glade_app_get_locale_dir ());
+  bind_textdomain_codeset (GETTEXT_PACKAGE, "UTF-8");
+  textdomain (GETTEXT_PACKAGE);
+#endif
+
+  context = g_option_context_new (_("- validates and saves glade UI definitions"));
+  g_option_context_add_main_entries (context, option_entries, GETTEXT_PACKAGE);
+  g_option_context_add_group (context, gtk_get_option_group (FALSE));
+
+  if (!g_option_context_parse (context, &argc, &argv, &error) ||
+      (verify_names && !parse_verify_flags (verify_names, &error)))
+    {
+      g_printerr (_("%s\nRun '%s --help' to see a full list of available command line "
+                   "options.\n"), error->message, argv[0]);
+      g_error_free (error);
+      g_option_context_free (context);
+      return 1;
+    }
+
+  g_option_context_free (context);
+
+  if (version)
+    {
+      g_print ("glade-validate " VERSION "\n");
+      return 0;
+    }
+
+  save = save || force;
+
+  if (worker_mode)
+    {
+      if (!worker_open_channel ())
+        {
+          g_printerr (_("Could not open the channel to the parent process.\n"));
+          return 1;
+        }
+
+      return init_glade (&argc, &argv) ? run_worker () : 1;
+    }
+
+  if (!file_names)
+    {
+      g_printerr (_("No files to validate were specified.\n"));
+      return 1;
+    }
+
+  if (report_file_name)
+    {
+      if (!(report_file = g_fopen (report_file_name, "w")))
+        {
+          g_printerr (_("Could not open report file %s.\n"), report_file_name);
+          return 1;
+        }
+    }
+  else
+    report_file = stdout;
+
+  if (jobs <= 0)
+    jobs = g_get_num_processors ();
+
+  start = g_get_monotonic_time ();
+  pool = pool_new (file_names, report_file);
+
+  /* Only workers load catalogs when validating in parallel */
+  if (jobs > 1 && pool->n_files > 1)
+    program = get_program_path (argv[0]);
+
+  if (!program || !pool_run (pool, program, MIN ((guint) jobs, pool->n_files)))
+    {
+      if (!init_glade (&argc, &argv))
+        return 1;
+
+      pool_run_in_process (pool);
+    }
+
+  fprintf (report_file,
+           "{\"summary\":{\"files\":%u,\"ok\":%u,\"problems\":%u,\"errors\":%u,\"elapsed\":%s}}\n",
+           pool->n_files,
+           pool->counts[FILE_OK],
+           pool->counts[FILE_PROBLEMS],
+           pool->counts[FILE_ERROR],
+           g_ascii_formatd (buffer, sizeof (buffer), "%.6f",
+                            (g_get_monotonic_time () - start) / (gdouble) G_USEC_PER_SEC));
+
+  retval = (pool->counts[FILE_OK] == pool->n_files) ? 0 : 1;
+
+  if (report_file != stdout)
+    fclose (report_file);
+
+  pool_free (pool);
+  g_free (program);
+  g_free (verify_names);
+  g_free (report_file_name);
+  g_strfreev (file_names);
+
+  return retval;
+}
@@ -86,6 +86,9 @@ typedef struct
                                      * managed on the GladePropertyDef proper.
                                      */
   GList       *signals;              /* List of GladeSignalDef objects */
+  GHashTable  *property_index;       /* Indexes of the property, packing property */
+  GHashTable  *packing_index;        /* and signal definitions by name, built once */
+  GHashTable  *signal_index;         /* the adaptor is registered */
   GList       *child_packings;       /* Default packing property values */
   GList       *actions;              /* A list of GladeWidgetActionDef */
   GList       *packing_actions;      /* A list of GladeWidgetActionDef for child objects */
@@ -96,13 +99,23 @@ typedef struct
   gchar       *book;                 /* DevHelp search namespace for this widget class
                                       */
 
-  GdkCursor   *cursor;                /* a cursor for inserting widgets */
+  GdkCursor   *cursor;                /* a cursor for inserting widgets, created
+                                       * the first time it is asked for
+                                       */
+  gboolean     cursor_created;
 
   gchar       *special_child_type;    /* Special case code for children that
                                        * are special children (like notebook tab 
                                        * widgets for example).
                                        */
   gboolean     query;                 /* Do we have to query the user, see glade_widget_adaptor_query() */
+
+  gboolean     materialized;          /* Whether properties and signals were built, see
+                                       * gwa_ensure_materialized()
+                                       */
+  GladeXmlNode *class_node;           /* Copy of the catalog node, kept until then */
+  GModule     *module;
+  gchar       *domain;
 } GladeWidgetAdaptorPrivate;
 
 struct _GladeChildPacking
@@ -146,6 +159,8 @@ typedef struct _GladeInternalChild GladeInternalChild;
 
 static GHashTable *adaptor_hash = NULL;
 
+static void gwa_ensure_materialized (GladeWidgetAdaptor *adaptor);
+
 /* This object used to be registered as GladeGObjectAdaptor but there is
  * no reason for it since the autogenerated class for GtkWidget is GladeGtkWidgetAdaptor
  * TODO: rename GladeWidgetAdaptor to GladeGObjectAdator or GladeObjectAdator
@@ -336,6 +351,91 @@ gwa_signal_find_comp (gpointer a, gpointer b)
   return strcmp (name, glade_signal_def_get_name (signal));
 }
 
+/* Indexes @properties by id and numbers them, widgets keep their
+ * properties in arrays indexed by these ordinals.
+ */
+static GHashTable *
+gwa_index_property_defs (GList *properties)
+{
+  GHashTable *index = g_hash_table_new (g_str_hash, g_str_equal);
+  GList *list;
+  gint ordinal = 0;
+
+  for (list = properties; list && list->data; list = list->next)
+    {
+      const gchar *id = glade_property_def_id (list->data);
+
+      _glade_property_def_set_ordinal (list->data, ordinal++);
+
+      /* Keep the first definition, like a walk over the list would */
+      if (id && !g_hash_table_contains (index, id))
+        g_hash_table_insert (index, (gpointer) id, list->data);
+    }
+
+  return index;
+}
+
+static void
+gwa_build_indexes (GladeWidgetAdaptor *adaptor)
+{
+  GladeWidgetAdaptorPrivate *priv = glade_widget_adaptor_get_instance_private (adaptor);
+  GList *list;
+
+  g_clear_pointer (&priv->property_index, g_hash_table_unref);
+  g_clear_pointer (&priv->packing_index, g_hash_table_unref);
+  g_clear_pointer (&priv->signal_index, g_hash_table_unref);
+
+  priv->property_index = gwa_index_property_defs (priv->properties);
+  priv->packing_index = gwa_index_property_defs (priv->packing_props);
+  priv->signal_index = g_hash_table_new (g_str_hash, g_str_equal);
+
+  for (list = priv->signals; list; list = list->next)
+    {
+      const gchar *name = glade_signal_def_get_name (list->data);
+
+      if (!g_hash_table_contains (priv->signal_index, name))
+        g_hash_table_insert (priv->signal_index, (gpointer) name, list->data);
+    }
+}
+
+/* Indexes @properties by their lowercase id, for the case insensitive
+ * lookups done while extending an adaptor from its catalog.
+ */
+static GHashTable *
+gwa_index_property_links (GList *properties)
+{
+  GHashTable *index = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
+  GList *list;
+
+  for (list = properties; list && list->data; list = list->next)
+    {
+      const gchar *id = glade_property_def_id (list->data);
+      gchar *key;
+
+      if (id == NULL)
+        continue;
+
+      key = g_ascii_strdown (id, -1);
+      if (g_hash_table_contains (index, key))
+        g_free (key);
+      else
+        g_hash_table_insert (index, key, list);
+    }
+
+  return index;
+}
+
+static GList *
+gwa_lookup_property_link (GHashTable *index, const gchar *id)
+{
+  gchar *key = g_ascii_strdown (id, -1);
+  GList *list = g_hash_table_lookup (index, key);
+
+  g_free (key);
+
+  return list;
+}
+
 static void
 gwa_add_signals (GladeWidgetAdaptor *adaptor, GList **signals, GType type)
 {
@@ -619,7 +719,6 @@ glade_widget_adaptor_constructor (GType                  type,
   GladeWidgetAdaptorPrivate *priv, *parent_priv;
   GladeWidgetAdaptor *adaptor, *parent_adaptor;
   GObject *ret_obj;
-  GObjectClass *object_class;
 
   glade_abort_if_derived_adaptors_exist (type);
 
@@ -640,16 +739,9 @@ glade_widget_adaptor_constructor (GType                  type,
   if (!priv->icon_name)
     priv->icon_name = g_strdup ("image-missing");
 
-  /* Let it leek */
-  if ((object_class = g_type_class_ref (priv->type)))
-    {
-      /* Build signals & properties */
-      priv->signals = gwa_list_signals (adaptor, priv->type);
-
-      gwa_inherit_signals (adaptor);
-      gwa_setup_properties (adaptor, object_class, FALSE);
-      gwa_setup_properties (adaptor, object_class, TRUE);
-    }
+  /* Signals and properties are built on first use,
+   * see gwa_ensure_materialized()
+   */
 
   /* Inherit packing defaults here */
   priv->child_packings = gwa_inherit_child_packing (adaptor);
@@ -742,6 +834,10 @@ glade_widget_adaptor_finalize (GObject *object)
   GladeWidgetAdaptorPrivate *priv = glade_widget_adaptor_get_instance_private (adaptor);
 
   /* Free properties and signals */
+  g_clear_pointer (&priv->property_index, g_hash_table_unref);
+  g_clear_pointer (&priv->packing_index, g_hash_table_unref);
+  g_clear_pointer (&priv->signal_index, g_hash_table_unref);
+
   g_list_free_full (priv->properties,
                     (GDestroyNotify) glade_property_def_free);
   priv->properties = NULL;
@@ -765,6 +861,9 @@ glade_widget_adaptor_finalize (GObject *object)
 
   g_clear_object (&priv->cursor);
 
+  g_clear_pointer (&priv->class_node, glade_xml_node_delete);
+  g_clear_pointer (&priv->domain, g_free);
+
   g_clear_pointer (&priv->type_func, g_free);
   g_clear_pointer (&priv->name, g_free);
   g_clear_pointer (&priv->generic_name, g_free);
@@ -887,6 +986,11 @@ glade_widget_adaptor_real_get_property (GObject    *object,
         g_value_set_string (value, priv->special_child_type);
         break;
       case PROP_CURSOR:
+        if (!priv->cursor_created)
+          {
+            priv->cursor_created = TRUE;
+            gwa_create_cursor (adaptor);
+          }
         g_value_set_pointer (value, priv->cursor);
         break;
       case PROP_QUERY:
@@ -1003,16 +1107,44 @@ glade_widget_adaptor_object_child_action_activate (GladeWidgetAdaptor *adaptor,
              priv->name, action_id);
 }
 
+/* Returns the ordinal of @property's definition in @adaptor, or -1 if
+ * it does not belong to @adaptor's properties.
+ */
+static gint
+gwa_property_slot (GladeWidgetAdaptor *adaptor,
+                   GladeProperty      *property,
+                   guint               n_slots)
+{
+  GladePropertyDef *pdef = glade_property_get_def (property);
+  gint ordinal = _glade_property_def_get_ordinal (pdef);
+
+  if (glade_property_def_get_adaptor (pdef) != adaptor ||
+      glade_property_def_get_is_packing (pdef) ||
+      ordinal < 0 || (guint) ordinal >= n_slots)
+    return -1;
+
+  return ordinal;
+}
+
 static void
 glade_widget_adaptor_object_read_widget (GladeWidgetAdaptor *adaptor,
                                          GladeWidget        *widget,
                                          GladeXmlNode       *node)
 {
+  GladeWidgetAdaptor *widget_adaptor = glade_widget_get_adaptor (widget);
   GladeXmlNode *iter_node;
   GladeSignal *signal;
   GladeProperty *property;
   gchar *name, *prop_name;
   GList *read_properties = NULL, *l;
+  guint32 *read_slots;
+  guint n_slots;
+
+  /* Properties are flagged as read in a bitset indexed by the ordinal
+   * of their definition, the few that have none go in a list.
+   */
+  n_slots = g_list_length ((GList *) glade_widget_adaptor_get_properties (widget_adaptor));
+  read_slots = g_new0 (guint32, n_slots / 32 + 1);
 
   /* Read in the properties */
   for (iter_node = glade_xml_node_get_children (node);
@@ -1031,8 +1163,14 @@ glade_widget_adaptor_object_read_widget (GladeWidgetAdaptor *adaptor,
       /* Some properties may be special child type of custom, just leave them for the adaptor */
       if ((property = glade_widget_get_property (widget, prop_name)) != NULL)
         {
+          gint ordinal = gwa_property_slot (widget_adaptor, property, n_slots);
+
           glade_property_read (property, glade_widget_get_project (widget), iter_node);
-          read_properties = g_list_prepend (read_properties, property);
+
+          if (ordinal >= 0)
+            read_slots[ordinal / 32] |= 1u << (ordinal % 32);
+          else
+            read_properties = g_list_prepend (read_properties, property);
         }
 
       g_free (prop_name);
@@ -1042,12 +1180,18 @@ glade_widget_adaptor_object_read_widget (GladeWidgetAdaptor *adaptor,
   /* Sync the remaining values not read in from the Glade file.. */
   for (l = glade_widget_get_properties (widget); l; l = l->next)
     {
+      gint ordinal;
+
       property = l->data;
+      ordinal = gwa_property_slot (widget_adaptor, property, n_slots);
 
-      if (!g_list_find (read_properties, property))
+      if (ordinal >= 0 ?
+          !(read_slots[ordinal / 32] & (1u << (ordinal % 32))) :
+          !g_list_find (read_properties, property))
         glade_property_sync (property);
     }
   g_list_free (read_properties);
+  g_free (read_slots);
 
   /* Read in the signals */
   for (iter_node = glade_xml_node_get_children (node);
@@ -1895,6 +2039,8 @@ glade_widget_adaptor_get_properties (GladeWidgetAdaptor *adaptor)
 
   g_return_val_if_fail (GLADE_IS_WIDGET_ADAPTOR (adaptor), NULL);
 
+  gwa_ensure_materialized (adaptor);
+
   return priv->properties;
 }
 
@@ -1911,6 +2057,8 @@ glade_widget_adaptor_get_packing_props (GladeWidgetAdaptor *adaptor)
 
   g_return_val_if_fail (GLADE_IS_WIDGET_ADAPTOR (adaptor), NULL);
 
+  gwa_ensure_materialized (adaptor);
+
   return priv->packing_props;
 }
 
@@ -1927,6 +2075,8 @@ glade_widget_adaptor_get_signals (GladeWidgetAdaptor *adaptor)
 
   g_return_val_if_fail (GLADE_IS_WIDGET_ADAPTOR (adaptor), NULL);
 
+  gwa_ensure_materialized (adaptor);
+
   return priv->signals;
 }
 
@@ -2106,6 +2256,7 @@ gwa_update_properties_from_node (GladeWidgetAdaptor *adaptor,
 {
   GladeWidgetAdaptorPrivate *priv = glade_widget_adaptor_get_instance_private (adaptor);
   GladeXmlNode *child;
+  GHashTable *index = gwa_index_property_links (*properties);
 
   for (child = glade_xml_node_get_children (node);
        child; child = glade_xml_node_next (child))
@@ -2127,15 +2278,7 @@ gwa_update_properties_from_node (GladeWidgetAdaptor *adaptor,
       glade_util_replace (id, '_', '-');
 
       /* find the property in our list, if not found append a new property */
-      for (list = *properties; list && list->data; list = list->next)
-        {
-          property_def = GLADE_PROPERTY_DEF (list->data);
-          if (glade_property_def_id (property_def) != NULL &&
-              g_ascii_strcasecmp (id, glade_property_def_id (property_def)) == 0)
-            break;
-        }
-
-      if (list)
+      if ((list = gwa_lookup_property_link (index, id)) != NULL)
         {
           property_def = GLADE_PROPERTY_DEF (list->data);
         }
@@ -2151,6 +2294,7 @@ gwa_update_properties_from_node (GladeWidgetAdaptor *adaptor,
 
           *properties = g_list_append (*properties, property_def);
           list = g_list_last (*properties);
+          g_hash_table_insert (index, g_ascii_strdown (id, -1), list);
         }
 
       if ((updated = glade_property_def_update_from_node (child, 
@@ -2166,10 +2310,18 @@ gwa_update_properties_from_node (GladeWidgetAdaptor *adaptor,
 
       /* if this pointer was set to null, its a property we dont handle. */
       if (!property_def)
-        *properties = g_list_delete_link (*properties, list);
+        {
+          gchar *key = g_ascii_strdown (id, -1);
+
+          g_hash_table_remove (index, key);
+          *properties = g_list_delete_link (*properties, list);
+          g_free (key);
+        }
 
       g_free (id);
     }
+
+  g_hash_table_unref (index);
 }
 
 static GParamSpec *
@@ -2309,6 +2461,7 @@ gwa_update_properties_from_type (GladeWidgetAdaptor *adaptor,
   gpointer object_class = g_type_class_ref (type);
   GParamSpec **specs = NULL, *spec;
   guint i, n_specs = 0;
+  GHashTable *index;
 
   /* only GtkContainer child properties can be introspected */
   if (is_packing && !g_type_is_a (priv->type, GTK_TYPE_CONTAINER))
@@ -2319,19 +2472,15 @@ gwa_update_properties_from_type (GladeWidgetAdaptor *adaptor,
   else
     specs = g_object_class_list_properties (object_class, &n_specs);
 
+  index = gwa_index_property_links (*properties);
+
   for (i = 0; i < n_specs; i++)
     {
       GladePropertyDef *property_def;
       GList *list;
 
       /* find the property in our list, if not found append a new property */
-      for (list = *properties; list && list->data; list = list->next)
-        {
-          property_def = GLADE_PROPERTY_DEF (list->data);
-          if (glade_property_def_id (property_def) != NULL &&
-              g_ascii_strcasecmp (specs[i]->name, glade_property_def_id (property_def)) == 0)
-            break;
-        }
+      list = gwa_lookup_property_link (index, specs[i]->name);
 
       if (list == NULL && (specs[i]->flags & G_PARAM_WRITABLE) &&
           (spec = pspec_dup (specs[i])))
@@ -2359,9 +2508,12 @@ gwa_update_properties_from_type (GladeWidgetAdaptor *adaptor,
           glade_property_def_set_is_packing (property_def, is_packing);
 
           *properties = g_list_append (*properties, property_def);
+          g_hash_table_insert (index, g_ascii_strdown (spec->name, -1),
+                               g_list_last (*properties));
         }
     }
 
+  g_hash_table_unref (index);
   g_free (specs);
 }
 
@@ -2509,22 +2661,10 @@ gwa_extend_with_node (GladeWidgetAdaptor *adaptor,
        glade_xml_get_value_string (node, GLADE_TAG_SPECIAL_CHILD_TYPE)) != NULL)
     priv->special_child_type = (g_free (priv->special_child_type), child_type);
 
-  if ((child = glade_xml_search_child (node, GLADE_TAG_PROPERTIES)) != NULL)
-    gwa_update_properties_from_node
-        (adaptor, child, module, &priv->properties, domain, FALSE);
-
-  if ((child =
-       glade_xml_search_child (node, GLADE_TAG_PACKING_PROPERTIES)) != NULL)
-    gwa_update_properties_from_node
-        (adaptor, child, module, &priv->packing_props, domain, TRUE);
-
   if ((child =
        glade_xml_search_child (node, GLADE_TAG_PACKING_DEFAULTS)) != NULL)
     gwa_set_packing_defaults_from_node (adaptor, child);
 
-  if ((child = glade_xml_search_child (node, GLADE_TAG_SIGNALS)) != NULL)
-    gwa_set_signals_from_node (adaptor, child, domain);
-
   if ((child = glade_xml_search_child (node, GLADE_TAG_ACTIONS)) != NULL)
     gwa_action_update_from_node (adaptor, FALSE, child, domain, NULL);
 
@@ -2605,6 +2745,120 @@ gwa_displayable_values_check (GladeWidgetAdaptor *adaptor, gboolean packing)
     }
 }
 
+/* Updates the property, packing property and signal definitions
+ * from the catalog, once they are built.
+ */
+static void
+gwa_extend_definitions_with_node (GladeWidgetAdaptor *adaptor,
+                                  GladeXmlNode       *node,
+                                  GModule            *module,
+                                  const gchar        *domain)
+{
+  GladeWidgetAdaptorPrivate *priv = glade_widget_adaptor_get_instance_private (adaptor);
+  GladeXmlNode *child;
+
+  if ((child = glade_xml_search_child (node, GLADE_TAG_PROPERTIES)) != NULL)
+    gwa_update_properties_from_node
+        (adaptor, child, module, &priv->properties, domain, FALSE);
+
+  if ((child =
+       glade_xml_search_child (node, GLADE_TAG_PACKING_PROPERTIES)) != NULL)
+    gwa_update_properties_from_node
+        (adaptor, child, module, &priv->packing_props, domain, TRUE);
+
+  if ((child = glade_xml_search_child (node, GLADE_TAG_SIGNALS)) != NULL)
+    gwa_set_signals_from_node (adaptor, child, domain);
+}
+
+/* Applies what is left of the catalog node to the definitions, then
+ * weights and indexes them.
+ */
+static void
+gwa_finish_definitions (GladeWidgetAdaptor *adaptor)
+{
+  GladeWidgetAdaptorPrivate *priv = glade_widget_adaptor_get_instance_private (adaptor);
+  GType parent_type;
+
+  if (priv->class_node)
+    {
+      gwa_extend_definitions_with_node (adaptor, priv->class_node,
+                                        priv->module, priv->domain);
+      g_clear_pointer (&priv->class_node, glade_xml_node_delete);
+      g_clear_pointer (&priv->domain, g_free);
+    }
+
+  /* Set default weight on properties */
+  for (parent_type = priv->type;
+       parent_type != 0; parent_type = g_type_parent (parent_type))
+    {
+      glade_property_def_set_weights (&priv->properties, parent_type);
+      glade_property_def_set_weights (&priv->packing_props, parent_type);
+    }
+
+  gwa_displayable_values_check (adaptor, FALSE);
+  gwa_displayable_values_check (adaptor, TRUE);
+
+  /* The definitions are final at this point, index them by name */
+  gwa_build_indexes (adaptor);
+}
+
+/* Builds the signal, property and packing property definitions of
+ * @adaptor the first time they are needed, after the ones of its parent
+ * adaptor since they are inherited. A session usually only touches a
+ * small part of the registered adaptors.
+ */
+static void
+gwa_ensure_materialized (GladeWidgetAdaptor *adaptor)
+{
+  GladeWidgetAdaptorPrivate *priv = glade_widget_adaptor_get_instance_private (adaptor);
+  GladeWidgetAdaptor *parent_adaptor;
+  GObjectClass *object_class;
+
+  if (priv->materialized)
+    return;
+
+  /* Lookups done while building fall back to walking the lists */
+  priv->materialized = TRUE;
+
+  if ((parent_adaptor = gwa_get_parent_adaptor (adaptor)) != NULL)
+    gwa_ensure_materialized (parent_adaptor);
+
+  GLADE_NOTE (CATALOGS, g_print ("CATALOGS: materializing %s\n", priv->name));
+
+  /* Let it leek */
+  if ((object_class = g_type_class_ref (priv->type)))
+    {
+      /* Build signals & properties */
+      priv->signals = gwa_list_signals (adaptor, priv->type);
+
+      gwa_inherit_signals (adaptor);
+      gwa_setup_properties (adaptor, object_class, FALSE);
+      gwa_setup_properties (adaptor, object_class, TRUE);
+    }
+
+  /* if adaptor->priv->type (the runtime used by glade) differs from adaptor->priv->name
+   * (the name specified in the catalog) means we are using the type specified in the
+   * the parent tag as the runtime and the class already exist.
+   * So we need to add the properties and signals from the real class
+   * even though they wont be applied at runtime.
+   */
+  if (priv->type != priv->real_type)
+    {
+      if (priv->signals)
+        g_list_free_full (priv->signals,
+                          (GDestroyNotify) glade_signal_def_free);
+
+      priv->signals = gwa_list_signals (adaptor, priv->real_type);
+
+      gwa_update_properties_from_type (adaptor, priv->real_type,
+                                       &priv->properties, FALSE);
+      gwa_update_properties_from_type (adaptor, priv->real_type,
+                                       &priv->packing_props, TRUE);
+    }
+
+  gwa_finish_definitions (adaptor);
+}
+
 static GType
 generate_type (const char *name, const char *parent_name)
 {
@@ -2763,7 +3017,6 @@ glade_widget_adaptor_from_catalog (GladeCatalog *catalog,
   gchar *title, *translated_title, *parent_name;
   GType object_type = G_TYPE_INVALID;
   GType adaptor_type = G_TYPE_INVALID;
-  GType parent_type = G_TYPE_INVALID;
   gchar *missing_icon = NULL;
   GWADerivedClassData data;
 
@@ -2981,26 +3234,6 @@ glade_widget_adaptor_from_catalog (GladeCatalog *catalog,
                  name, GLADE_TAG_GENERIC_NAME);
     }
 
-  /* if adaptor->priv->type (the runtime used by glade) differs from adaptor->priv->name
-   * (the name specified in the catalog) means we are using the type specified in the
-   * the parent tag as the runtime and the class already exist.
-   * So we need to add the properties and signals from the real class
-   * even though they wont be applied at runtime.
-   */
-  if (priv->type != priv->real_type)
-    {
-      if (priv->signals)
-        g_list_free_full (priv->signals,
-                          (GDestroyNotify) glade_signal_def_free);
-
-      priv->signals = gwa_list_signals (adaptor, priv->real_type);
-
-      gwa_update_properties_from_type (adaptor, priv->real_type,
-                                       &priv->properties, FALSE);
-      gwa_update_properties_from_type (adaptor, priv->real_type,
-                                       &priv->packing_props, TRUE);
-    }
-
   /* Perform a stoopid fallback just incase */
   if (priv->generic_name == NULL)
     priv->generic_name = g_strdup ("widget");
@@ -3014,6 +3247,16 @@ glade_widget_adaptor_from_catalog (GladeCatalog *catalog,
   gwa_extend_with_node (adaptor, class_node, module,
                         glade_catalog_get_domain (catalog));
 
+  /* Keep what is needed to build the definitions later on, unless
+   * something already needed them while the adaptor was constructed.
+   */
+  priv->class_node = glade_xml_node_copy (class_node);
+  priv->module = module;
+  priv->domain = g_strdup (glade_catalog_get_domain (catalog));
+
+  if (priv->materialized)
+    gwa_finish_definitions (adaptor);
+
   /* Finalize the icon and overlay it if it's deprecated */
   if (GLADE_WIDGET_ADAPTOR_DEPRECATED (adaptor))
     {
@@ -3023,19 +3266,9 @@ glade_widget_adaptor_from_catalog (GladeCatalog *catalog,
       priv->icon_name = deprecated_icon;
     }
 
-  /* Postpone creating the cursor until we have the right graphic for it */
-  gwa_create_cursor (adaptor);
-
-  /* Set default weight on properties */
-  for (parent_type = priv->type;
-       parent_type != 0; parent_type = g_type_parent (parent_type))
-    {
-      glade_property_def_set_weights (&priv->properties, parent_type);
-      glade_property_def_set_weights (&priv->packing_props, parent_type);
-    }
-
-  gwa_displayable_values_check (adaptor, FALSE);
-  gwa_displayable_values_check (adaptor, TRUE);
+  /* The cursor is only created when first asked for, once the
+   * icon is final.
+   */
 
   glade_widget_adaptor_register (adaptor);
 
@@ -3192,6 +3425,10 @@ glade_widget_adaptor_get_by_name (const gchar *name)
 {
   GType type = g_type_from_name (name);
 
+  /* The class may come from a catalog which is not loaded yet */
+  if (!type && _glade_catalog_load_deferred_class (name))
+    type = g_type_from_name (name);
+
   if (adaptor_hash && type)
     return g_hash_table_lookup (adaptor_hash, GSIZE_TO_POINTER (type));
 
@@ -3271,6 +3508,11 @@ glade_widget_adaptor_get_property_def (GladeWidgetAdaptor *adaptor,
   GList *list;
   GladePropertyDef *pdef;
 
+  gwa_ensure_materialized (adaptor);
+
+  if (priv->property_index)
+    return g_hash_table_lookup (priv->property_index, name);
+
   for (list = priv->properties; list && list->data; list = list->next)
     {
       pdef = list->data;
@@ -3297,6 +3539,11 @@ glade_widget_adaptor_get_pack_property_def (GladeWidgetAdaptor *adaptor,
   GList *list;
   GladePropertyDef *pdef;
 
+  gwa_ensure_materialized (adaptor);
+
+  if (priv->packing_index)
+    return g_hash_table_lookup (priv->packing_index, name);
+
   for (list = priv->packing_props; list && list->data; list = list->next)
     {
       pdef = list->data;
@@ -3930,6 +4177,8 @@ glade_widget_adaptor_query (GladeWidgetAdaptor *adaptor)
   if (!priv->query)
     return FALSE;
 
+  gwa_ensure_materialized (adaptor);
+
   for (l = priv->properties; l; l = l->next)
     {
       pdef = l->data;
@@ -4601,6 +4850,11 @@ glade_widget_adaptor_get_signal_def (GladeWidgetAdaptor *adaptor,
   g_return_val_if_fail (GLADE_IS_WIDGET_ADAPTOR (adaptor), NULL);
   g_return_val_if_fail (name != NULL, NULL);
 
+  gwa_ensure_materialized (adaptor);
+
+  if (priv->signal_index)
+    return g_hash_table_lookup (priv->signal_index, name);
+
   for (list = priv->signals; list; list = list->next)
     {
       signal = list->data;
@@ -4651,3 +4905,14 @@ glade_widget_adaptor_get_type_func (GladeWidgetAdaptor *adaptor)
 
   return priv->type_func;
 }
+
+/* Whether the definitions of @adaptor were built already */
+gboolean
+_glade_widget_adaptor_is_materialized (GladeWidgetAdaptor *adaptor)
+{
+  GladeWidgetAdaptorPrivate *priv = glade_widget_adaptor_get_instance_private (adaptor);
+
+  g_return_val_if_fail (GLADE_IS_WIDGET_ADAPTOR (adaptor), FALSE);
+
+  return priv->materialized;
+}
@@ -119,10 +119,10 @@ struct _GladeWidgetPrivate {
                               * GladeWidgetClass.
                               */
 
-  GHashTable *props_hash; /* A Quick reference table to speed up calls to glade_widget_get_property()
-                           */
-  GHashTable *pack_props_hash; /* A Quick reference table to speed up calls to glade_widget_get_pack_property()
-                                */
+  GPtrArray *prop_slots;      /* The properties and packing properties indexed by the ordinal */
+  GPtrArray *pack_prop_slots; /* of their GladePropertyDef, to speed up calls to
+                               * glade_widget_get_property() and glade_widget_get_pack_property()
+                               */
 
   GHashTable *signals; /* A table with a GPtrArray of GladeSignals (signal handlers),
                         * indexed by its name */
@@ -162,6 +162,9 @@ struct _GladeWidgetPrivate {
                                    */
   guint              rebuilding : 1;
   guint              composite : 1;
+
+  guint              props_unslotted : 1;      /* Whether some properties or packing properties */
+  guint              pack_props_unslotted : 1; /* are missing from the slot arrays */
 };
 
 enum
@@ -211,6 +214,14 @@ G_DEFINE_TYPE_WITH_CODE (GladeWidget, glade_widget, G_TYPE_INITIALLY_UNOWNED,
                          G_IMPLEMENT_INTERFACE (GLADE_TYPE_DRAG, 
                                                 glade_widget_drag_init))
 
+/* Any change to the serialized form of @widget must call this */
+static void
+glade_widget_invalidate_write_cache (GladeWidget *widget)
+{
+  if (widget && widget->priv->project)
+    _glade_project_write_cache_invalidate (widget->priv->project, widget);
+}
+
 /*******************************************************************************
                            GladeWidget class methods
  *******************************************************************************/
@@ -779,6 +790,108 @@ glade_widget_dup_properties (GladeWidget *dest_widget,
   return g_list_reverse (properties);
 }
 
+/* Fills @slots with @properties indexed by the ordinal of their definition
+ * in their adaptor, returns %FALSE if some of them could not be placed.
+ */
+static gboolean
+glade_widget_fill_slots (GPtrArray *slots, GList *properties)
+{
+  GladeWidgetAdaptor *adaptor = NULL;
+  gboolean complete = TRUE;
+  GList *l;
+
+  g_ptr_array_set_size (slots, 0);
+
+  for (l = properties; l && l->data; l = l->next)
+    {
+      GladePropertyDef *pdef = glade_property_get_def (l->data);
+      gint ordinal = _glade_property_def_get_ordinal (pdef);
+
+      /* Lookups go through the adaptor of the first property */
+      if (adaptor == NULL)
+        adaptor = glade_property_def_get_adaptor (pdef);
+
+      if (ordinal < 0 || glade_property_def_get_adaptor (pdef) != adaptor)
+        {
+          complete = FALSE;
+          continue;
+        }
+
+      if ((guint) ordinal >= slots->len)
+        g_ptr_array_set_size (slots, ordinal + 1);
+
+      if (g_ptr_array_index (slots, ordinal) != NULL)
+        complete = FALSE;
+      else
+        g_ptr_array_index (slots, ordinal) = l->data;
+    }
+
+  return complete;
+}
+
+static GladeProperty *
+glade_widget_lookup_slot (GPtrArray   *slots,
+                          GList       *properties,
+                          gboolean     complete,
+                          gboolean     packing,
+                          const gchar *id)
+{
+  GladeWidgetAdaptor *adaptor;
+  GladePropertyDef *pdef;
+  GladeProperty *property;
+  GList *l;
+  gint ordinal;
+
+  if (slots == NULL || properties == NULL)
+    return NULL;
+
+  adaptor = glade_property_def_get_adaptor (glade_property_get_def (properties->data));
+  pdef = packing ?
+    glade_widget_adaptor_get_pack_property_def (adaptor, id) :
+    glade_widget_adaptor_get_property_def (adaptor, id);
+
+  if (pdef && (ordinal = _glade_property_def_get_ordinal (pdef)) >= 0 &&
+      (guint) ordinal < slots->len &&
+      (property = g_ptr_array_index (slots, ordinal)) != NULL &&
+      glade_property_get_def (property) == pdef)
+    return property;
+
+  if (complete)
+    return NULL;
+
+  /* Not every property has a slot, look for it in the list */
+  for (l = properties; l && l->data; l = l->next)
+    {
+      GladePropertyDef *def = glade_property_get_def (l->data);
+
+      if (strcmp (glade_property_def_id (def), id) == 0)
+        return l->data;
+    }
+
+  return NULL;
+}
+
+static void
+glade_widget_clear_slot (GPtrArray *slots, GladeProperty *property)
+{
+  gint ordinal = _glade_property_def_get_ordinal (glade_property_get_def (property));
+
+  if (slots && ordinal >= 0 && (guint) ordinal < slots->len &&
+      g_ptr_array_index (slots, ordinal) == property)
+    g_ptr_array_index (slots, ordinal) = NULL;
+}
+
+static void
+glade_widget_update_pack_slots (GladeWidget *widget)
+{
+  if (widget->priv->pack_prop_slots == NULL)
+    widget->priv->pack_prop_slots = g_ptr_array_new ();
+
+  widget->priv->pack_props_unslotted =
+    !glade_widget_fill_slots (widget->priv->pack_prop_slots,
+                              widget->priv->packing_properties);
+}
+
 /**
  * glade_widget_remove_property:
  * @widget: A #GladeWidget
@@ -800,14 +913,15 @@ glade_widget_remove_property (GladeWidget *widget, const gchar *id_property)
   g_return_if_fail (id_property);
 
   /* XXX FIXME: currently we aren't calling this on packing properties,
-   * but doing so could cause crashes because the hash table is not
+   * but doing so could cause crashes because the slots are not
    * managed properly
    */
   if ((prop = glade_widget_get_property (widget, id_property)) != NULL)
     {
       widget->priv->properties = g_list_remove (widget->priv->properties, prop);
-      g_hash_table_remove (widget->priv->props_hash, id_property);
+      glade_widget_clear_slot (widget->priv->prop_slots, prop);
       g_object_unref (prop);
+      glade_widget_invalidate_write_cache (widget);
     }
   else
     g_critical ("Couldnt find property %s on widget %s\n",
@@ -977,10 +1091,8 @@ glade_widget_finalize (GObject *object)
   g_free (widget->priv->support_warning);
   g_hash_table_destroy (widget->priv->signals);
 
-  if (widget->priv->props_hash)
-    g_hash_table_destroy (widget->priv->props_hash);
-  if (widget->priv->pack_props_hash)
-    g_hash_table_destroy (widget->priv->pack_props_hash);
+  g_clear_pointer (&widget->priv->prop_slots, g_ptr_array_unref);
+  g_clear_pointer (&widget->priv->pack_prop_slots, g_ptr_array_unref);
 
   G_OBJECT_CLASS (glade_widget_parent_class)->finalize (object);
 }
@@ -1031,11 +1143,7 @@ glade_widget_dispose (GObject *object)
       g_list_free_full (widget->priv->properties, g_object_unref);
       widget->priv->properties = NULL;
     }
-  if (widget->priv->props_hash)
-    {
-      g_hash_table_destroy (widget->priv->props_hash);
-      widget->priv->props_hash = NULL;
-    }
+  g_clear_pointer (&widget->priv->prop_slots, g_ptr_array_unref);
 
   glade_widget_set_object (widget, NULL);
 
@@ -1044,6 +1152,7 @@ glade_widget_dispose (GObject *object)
       g_list_free_full (widget->priv->packing_properties, g_object_unref);
       widget->priv->packing_properties = NULL;
     }
+  g_clear_pointer (&widget->priv->pack_prop_slots, g_ptr_array_unref);
 
   if (widget->priv->actions)
     {
@@ -1744,10 +1853,13 @@ glade_widget_dup_internal (GladeWidget *main_target,
     glade_widget_copy_properties (gwidget, template_widget, TRUE, exact);
 
   if (gwidget->priv->packing_properties == NULL)
-    gwidget->priv->packing_properties =
+    {
+      gwidget->priv->packing_properties =
         glade_widget_dup_properties (gwidget,
                                      template_widget->priv->packing_properties, FALSE,
                                      FALSE, FALSE);
+      glade_widget_update_pack_slots (gwidget);
+    }
 
   /* If custom properties are still at their
    * default value, they need to be synced.
@@ -1953,24 +2065,17 @@ glade_widget_set_properties (GladeWidget *widget, GList *properties)
       if (widget->priv->properties)
           g_list_free_full (widget->priv->properties, g_object_unref);
 
-      if (widget->priv->props_hash)
-        g_hash_table_destroy (widget->priv->props_hash);
+      if (widget->priv->prop_slots == NULL)
+        widget->priv->prop_slots = g_ptr_array_new ();
 
       widget->priv->properties = properties;
-      widget->priv->props_hash = g_hash_table_new (g_str_hash, g_str_equal);
+      widget->priv->props_unslotted =
+        !glade_widget_fill_slots (widget->priv->prop_slots, properties);
 
       for (list = properties; list; list = list->next)
         {
-          GladePropertyDef *pdef;
-
           property = list->data;
-
-          pdef = glade_property_get_def (property);
           glade_property_set_widget (property, widget);
-
-          g_hash_table_insert (widget->priv->props_hash, 
-                               (gchar *)glade_property_def_id (pdef), 
-                               property);
         }
     }
 }
@@ -2146,6 +2251,9 @@ glade_widget_add_prop_ref (GladeWidget *widget, GladeProperty *property)
   if (!g_list_find (widget->priv->prop_refs, property))
     widget->priv->prop_refs = g_list_prepend (widget->priv->prop_refs, property);
 
+  if (widget->priv->project)
+    _glade_project_prop_refs_changed (widget->priv->project, widget);
+
   /* parentless widget reffed widgets are added to their referring widgets. 
    * they cant be in the design view.
    */
@@ -2181,6 +2289,9 @@ glade_widget_remove_prop_ref (GladeWidget *widget, GladeProperty *property)
 
   widget->priv->prop_refs = g_list_remove (widget->priv->prop_refs, property);
 
+  if (widget->priv->project)
+    _glade_project_prop_refs_changed (widget->priv->project, widget);
+
   pdef = glade_property_get_def (property);
   if (glade_property_def_parentless_widget (pdef))
     {
@@ -2456,7 +2567,9 @@ glade_widget_add_child (GladeWidget *parent,
   g_return_if_fail (GLADE_IS_WIDGET (parent));
   g_return_if_fail (GLADE_IS_WIDGET (child));
 
+  glade_widget_invalidate_write_cache (child);
   GLADE_WIDGET_GET_CLASS (parent)->add_child (parent, child, at_mouse);
+  glade_widget_invalidate_write_cache (parent);
 }
 
 /**
@@ -2472,7 +2585,9 @@ glade_widget_remove_child (GladeWidget *parent, GladeWidget *child)
   g_return_if_fail (GLADE_IS_WIDGET (parent));
   g_return_if_fail (GLADE_IS_WIDGET (child));
 
+  glade_widget_invalidate_write_cache (parent);
   GLADE_WIDGET_GET_CLASS (parent)->remove_child (parent, child);
+  glade_widget_invalidate_write_cache (child);
 }
 
 /**
@@ -2721,6 +2836,8 @@ glade_widget_list_signal_handlers (GladeWidget *widget, const gchar *signal_name
 void
 glade_widget_set_name (GladeWidget *widget, const gchar *name)
 {
+  GList *l;
+
   g_return_if_fail (GLADE_IS_WIDGET (widget));
   if (widget->priv->name != name)
     {
@@ -2728,6 +2845,12 @@ glade_widget_set_name (GladeWidget *widget, const gchar *name)
         g_free (widget->priv->name);
 
       widget->priv->name = g_strdup (name);
+
+      /* Properties referring to this widget are serialized by name */
+      glade_widget_invalidate_write_cache (widget);
+      for (l = widget->priv->prop_refs; l; l = l->next)
+        glade_widget_invalidate_write_cache (glade_property_get_widget (l->data));
+
       g_object_notify_by_pspec (G_OBJECT (widget), properties[PROP_NAME]);
     }
 }
@@ -2805,6 +2928,7 @@ glade_widget_set_is_composite (GladeWidget *widget, gboolean composite)
       GladeProject *project = glade_widget_get_project (widget);
 
       widget->priv->composite = composite;
+      glade_widget_invalidate_write_cache (widget);
 
       g_object_notify_by_pspec (G_OBJECT (widget), properties[PROP_COMPOSITE]);
 
@@ -2939,8 +3063,10 @@ glade_widget_get_property (GladeWidget *widget, const gchar *id_property)
   g_return_val_if_fail (GLADE_IS_WIDGET (widget), NULL);
   g_return_val_if_fail (id_property != NULL, NULL);
 
-  if (widget->priv->props_hash &&
-      (property = g_hash_table_lookup (widget->priv->props_hash, id_property)))
+  if ((property = glade_widget_lookup_slot (widget->priv->prop_slots,
+                                            widget->priv->properties,
+                                            !widget->priv->props_unslotted,
+                                            FALSE, id_property)) != NULL)
     return property;
 
   return glade_widget_get_pack_property (widget, id_property);
@@ -2961,11 +3087,10 @@ glade_widget_get_pack_property (GladeWidget *widget, const gchar *id_property)
   g_return_val_if_fail (GLADE_IS_WIDGET (widget), NULL);
   g_return_val_if_fail (id_property != NULL, NULL);
 
-  if (widget->priv->pack_props_hash &&
-      (property = g_hash_table_lookup (widget->priv->pack_props_hash, id_property)))
-    return property;
-
-  return NULL;
+  return glade_widget_lookup_slot (widget->priv->pack_prop_slots,
+                                   widget->priv->packing_properties,
+                                   !widget->priv->pack_props_unslotted,
+                                   TRUE, id_property);
 }
 
 
@@ -3859,9 +3984,8 @@ glade_widget_set_packing_properties (GladeWidget *widget,
   g_list_free_full (widget->priv->packing_properties, g_object_unref);
   widget->priv->packing_properties = NULL;
 
-  if (widget->priv->pack_props_hash)
-    g_hash_table_destroy (widget->priv->pack_props_hash);
-  widget->priv->pack_props_hash = NULL;
+  if (widget->priv->pack_prop_slots)
+    g_ptr_array_set_size (widget->priv->pack_prop_slots, 0);
 
   /* We have to detect whether this is an anarchist child of a composite
    * widget or not, in otherwords; whether its really a direct child or
@@ -3872,18 +3996,9 @@ glade_widget_set_packing_properties (GladeWidget *widget,
 
   widget->priv->packing_properties =
       glade_widget_create_packing_properties (container, widget);
-  widget->priv->pack_props_hash = g_hash_table_new (g_str_hash, g_str_equal);
 
-  /* update the quick reference hash table */
-  for (list = widget->priv->packing_properties; list && list->data; list = list->next)
-    {
-      GladeProperty    *property = list->data;
-      GladePropertyDef *pdef = glade_property_get_def (property);
-
-      g_hash_table_insert (widget->priv->pack_props_hash, 
-                           (gchar *)glade_property_def_id (pdef), 
-                           property);
-    }
+  /* update the quick reference slots */
+  glade_widget_update_pack_slots (widget);
 
   /* Dont introspect on properties that are not parented yet.
    */
@@ -3963,6 +4078,7 @@ glade_widget_replace (GladeWidget *parent,
 
   GLADE_WIDGET_GET_CLASS (parent)->replace_child (parent, old_object,
                                                   new_object);
+  glade_widget_invalidate_write_cache (parent);
 }
 
 /*******************************************************************************
@@ -47,6 +47,7 @@
 #include <libxml/parser.h>
 #include <libxml/parserInternals.h>
 #include <libxml/xmlmemory.h>
+#include <libxml/xmlreader.h>
 
 struct _GladeXmlNode
 {
@@ -1110,6 +1111,185 @@ glade_xml_node_add_next_sibling (GladeXmlNode *node, GladeXmlNode *new_node)
 /* Private API */
 #include "glade-private.h"
 
+GladeXmlNode *
+_glade_xml_node_get_last_child (GladeXmlNode *node_in)
+{
+  xmlNodePtr node = (xmlNodePtr) node_in;
+
+  return (GladeXmlNode *) xmlGetLastChild (node);
+}
+
+/* Dumps @node and its children indented as a child of the root node */
+gchar *
+_glade_xml_node_dump (GladeXmlNode *node_in)
+{
+  xmlNodePtr node = (xmlNodePtr) node_in;
+  xmlBufferPtr buffer;
+  gchar *text;
+
+  g_return_val_if_fail (node != NULL, NULL);
+
+  buffer = xmlBufferCreate ();
+  xmlNodeDump (buffer, node->doc, node, 1, 1);
+  text = g_strdup ((const gchar *) xmlBufferContent (buffer));
+  xmlBufferFree (buffer);
+
+  return text;
+}
+
+/* Dumps @doc the same way glade_xml_doc_save() writes it to disk,
+ * this only touches @doc so it can be used from any thread as long
+ * as nothing else uses @doc at the same time.
+ */
+gchar *
+_glade_xml_doc_dump (GladeXmlDoc *doc_in, gsize *length)
+{
+  xmlChar *string = NULL;
+  int size = 0;
+
+  g_return_val_if_fail (doc_in != NULL, NULL);
+
+  xmlDocDumpFormatMemoryEnc (doc_in->doc, &string, &size, "UTF-8", 1);
+
+  if (length)
+    *length = size;
+
+  return claim_string (string);
+}
+
+/* Streaming reader */
+struct _GladeXmlReader
+{
+  xmlTextReaderPtr reader;
+  xmlDocPtr skeleton;           /* Comments before the root element and a childless copy of it */
+  guint expanded : 1;           /* Whether the current node subtree was expanded */
+  guint failed : 1;             /* Whether a parse error was found */
+};
+
+/* Opens @full_path and reads up to its root element, the rest of the
+ * file is only read as _glade_xml_reader_next_child() is called so that
+ * only one child of the root element is kept in memory at a time.
+ *
+ * Returns %NULL if the file could not be read or has no root element.
+ */
+GladeXmlReader *
+_glade_xml_reader_new (const gchar *full_path)
+{
+  GladeXmlReader *reader;
+  xmlTextReaderPtr xreader;
+  xmlNodePtr node;
+  gint ret;
+
+  g_return_val_if_fail (full_path != NULL, NULL);
+
+  if (!(xreader = xmlReaderForFile (full_path, NULL, 0)))
+    return NULL;
+
+  reader = g_new0 (GladeXmlReader, 1);
+  reader->reader = xreader;
+  reader->skeleton = xmlNewDoc (BAD_CAST ("1.0"));
+
+  while ((ret = xmlTextReaderRead (xreader)) == 1)
+    {
+      if (!(node = xmlTextReaderCurrentNode (xreader)))
+        break;
+
+      if (node->type == XML_COMMENT_NODE)
+        xmlAddChild ((xmlNodePtr) reader->skeleton,
+                     xmlDocCopyNode (node, reader->skeleton, 1));
+      else if (node->type == XML_ELEMENT_NODE)
+        {
+          /* Copy the root element with its attributes and namespaces only */
+          xmlDocSetRootElement (reader->skeleton,
+                                xmlDocCopyNode (node, reader->skeleton, 2));
+          return reader;
+        }
+    }
+
+  _glade_xml_reader_free (reader);
+
+  return NULL;
+}
+
+void
+_glade_xml_reader_free (GladeXmlReader *reader)
+{
+  if (reader == NULL)
+    return;
+
+  xmlFreeTextReader (reader->reader);
+  xmlFreeDoc (reader->skeleton);
+  g_free (reader);
+}
+
+/* Returns the root element copy, which is owned by the reader. Nodes
+ * appended to it will stay around until the reader is freed.
+ */
+GladeXmlNode *
+_glade_xml_reader_get_root (GladeXmlReader *reader)
+{
+  g_return_val_if_fail (reader != NULL, NULL);
+
+  return (GladeXmlNode *) xmlDocGetRootElement (reader->skeleton);
+}
+
+/* Returns the next element or comment inside the root element with its
+ * whole subtree, the node is only valid until the next call.
+ *
+ * Returns %NULL once the root element is closed or if a parse error is
+ * found, see _glade_xml_reader_failed().
+ */
+GladeXmlNode *
+_glade_xml_reader_next_child (GladeXmlReader *reader)
+{
+  xmlTextReaderPtr xreader;
+  xmlNodePtr node;
+  gint ret, type, depth;
+
+  g_return_val_if_fail (reader != NULL, NULL);
+
+  xreader = reader->reader;
+
+  /* Skip over the subtree returned last time, the reader frees
+   * already visited siblings as it moves forward.
+   */
+  ret = reader->expanded ? xmlTextReaderNext (xreader) : xmlTextReaderRead (xreader);
+  reader->expanded = FALSE;
+
+  for (; ret == 1; ret = xmlTextReaderRead (xreader))
+    {
+      type = xmlTextReaderNodeType (xreader);
+      depth = xmlTextReaderDepth (xreader);
+
+      /* The root element was closed */
+      if (depth == 0)
+        return NULL;
+
+      if (depth == 1 &&
+          (type == XML_READER_TYPE_ELEMENT || type == XML_READER_TYPE_COMMENT))
+        {
+          if (!(node = xmlTextReaderExpand (xreader)))
+            break;
+
+          reader->expanded = TRUE;
+          return (GladeXmlNode *) node;
+        }
+    }
+
+  if (ret != 0)
+    reader->failed = TRUE;
+
+  return NULL;
+}
+
+gboolean
+_glade_xml_reader_failed (GladeXmlReader *reader)
+{
+  g_return_val_if_fail (reader != NULL, TRUE);
+
+  return reader->failed;
+}
+
 void
 _glade_xml_error_reset_last (void)
 {
@@ -76,8 +76,9 @@ glade_glade_editor_skeleton_read_widget (GladeWidgetAdaptor *adaptor,
        * (i.e. lookup the actual objects after they've been parsed and
        * are present).
        */
-      g_object_set_data_full (G_OBJECT (property),
-                              "glade-loaded-object", string, g_free);
+      glade_project_queue_object_reference (glade_widget_get_project (widget),
+                                            property, string);
+      g_free (string);
     }
 }
 
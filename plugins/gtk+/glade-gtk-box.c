@@ -146,6 +146,95 @@ glade_gtk_box_get_children (GladeWidgetAdaptor *adaptor, GObject *container)
   return g_list_sort_with_data (children, (GCompareDataFunc) sort_box_children, container);
 }
 
+/* Reorders every child to the position glade has for it, in a single pass
+ * over the children sorted by position.
+ */
+static void
+glade_gtk_box_apply_positions (GObject *box)
+{
+  GladeWidget *gbox = glade_widget_get_from_gobject (box);
+  GList *children, *list;
+
+  g_object_set_data (box, "glade-gtk-box-reorder", NULL);
+
+  children = glade_widget_get_children (gbox);
+
+  for (list = children; list; list = list->next)
+    {
+      GladeWidget *gchild = glade_widget_get_from_gobject (list->data);
+      gint position;
+
+      g_object_set_data (list->data, "glade-gtk-box-position", NULL);
+
+      if (gchild == NULL)
+        continue;
+
+      glade_widget_pack_property_get (gchild, "position", &position);
+      gtk_box_reorder_child (GTK_BOX (box), GTK_WIDGET (list->data), position);
+    }
+
+  g_list_free (children);
+
+  gtk_container_check_resize (GTK_CONTAINER (box));
+}
+
+static void
+glade_gtk_box_positions_parse_finished (GladeProject *project, GObject *box)
+{
+  g_signal_handlers_disconnect_by_func (project, glade_gtk_box_positions_parse_finished, box);
+
+  if (g_object_get_data (box, "glade-gtk-box-reorder"))
+    glade_gtk_box_apply_positions (box);
+}
+
+static void
+glade_gtk_box_positions_changed (GladeProject *project,
+                                 GladeCommand *command,
+                                 gboolean      forward,
+                                 GObject      *box)
+{
+  g_signal_handlers_disconnect_by_func (project, glade_gtk_box_positions_changed, box);
+
+  if (g_object_get_data (box, "glade-gtk-box-reorder"))
+    glade_gtk_box_apply_positions (box);
+}
+
+/* Whether position changes should only be recorded for now and applied all
+ * at once later on: while the project is loading, until parse-finished, and
+ * inside a command group like the ones creating, pasting or dropping
+ * widgets, until the command changed the project.
+ */
+static gboolean
+glade_gtk_box_defer_positions (GObject *box)
+{
+  GladeWidget *gbox = glade_widget_get_from_gobject (box);
+  GladeProject *project = glade_widget_get_project (gbox);
+  gboolean loading;
+
+  if (project == NULL)
+    return FALSE;
+
+  if (!(loading = glade_project_is_loading (project)) &&
+      glade_command_get_group_depth () == 0)
+    return FALSE;
+
+  if (!g_object_get_data (box, "glade-gtk-box-reorder"))
+    {
+      g_object_set_data (box, "glade-gtk-box-reorder", GINT_TO_POINTER (TRUE));
+
+      if (loading)
+        g_signal_connect_object (project, "parse-finished",
+                                 G_CALLBACK (glade_gtk_box_positions_parse_finished),
+                                 box, 0);
+      else
+        g_signal_connect_object (project, "changed",
+                                 G_CALLBACK (glade_gtk_box_positions_changed),
+                                 box, 0);
+    }
+
+  return TRUE;
+}
+
 void
 glade_gtk_box_set_child_property (GladeWidgetAdaptor *adaptor,
                                   GObject            *container,
@@ -183,7 +272,44 @@ glade_gtk_box_set_child_property (GladeWidgetAdaptor *adaptor,
       new_position = g_value_get_int (value);
     }
 
-  if (is_position && recursion == FALSE)
+  if (is_position && recursion == FALSE &&
+      glade_gtk_box_defer_positions (container))
+    {
+      /* The child only moves when the batch is applied, the position it
+       * was given last stands for the one it would have had by now.
+       */
+      if (g_object_get_data (child, "glade-gtk-box-position"))
+        old_position = GPOINTER_TO_INT (g_object_get_data (child, "glade-gtk-box-position")) - 1;
+
+      g_object_set_data (child, "glade-gtk-box-position", GINT_TO_POINTER (new_position + 1));
+
+      /* Give the child at the new position the old one, like below */
+      children = glade_property_superuser () ? NULL :
+        gtk_container_get_children (GTK_CONTAINER (container));
+
+      for (list = children; list; list = list->next)
+        {
+          gchild_iter = glade_widget_get_from_gobject (list->data);
+
+          if (gchild_iter == NULL || gchild_iter == gchild)
+            continue;
+
+          glade_widget_pack_property_get (gchild_iter, "position", &iter_position);
+
+          if (iter_position == new_position)
+            {
+              recursion = TRUE;
+              glade_widget_pack_property_set (gchild_iter, "position", old_position);
+              recursion = FALSE;
+
+              g_object_set_data (list->data, "glade-gtk-box-position",
+                                 GINT_TO_POINTER (old_position + 1));
+            }
+        }
+
+      g_list_free (children);
+    }
+  else if (is_position && recursion == FALSE)
     {
       children = glade_widget_get_children (gbox);
       children = g_list_sort (children, (GCompareFunc) sort_box_children);
@@ -221,21 +347,11 @@ glade_gtk_box_set_child_property (GladeWidgetAdaptor *adaptor,
             }
         }
 
-      for (list = children; list; list = list->next)
-        {
-          gchild_iter = glade_widget_get_from_gobject (list->data);
-
-          /* Refresh values yet again */
-          glade_widget_pack_property_get
-              (gchild_iter, "position", &iter_position);
-
-          gtk_box_reorder_child (GTK_BOX (container),
-                                 GTK_WIDGET (list->data), iter_position);
-
-        }
-
       if (children)
         g_list_free (children);
+
+      /* Refresh values yet again */
+      glade_gtk_box_apply_positions (container);
     }
 
   /* Chain Up */
@@ -563,6 +679,7 @@ glade_gtk_box_remove_child (GladeWidgetAdaptor *adaptor,
       return;
     }
 
+  g_object_set_data (child, "glade-gtk-box-position", NULL);
   gtk_container_remove (GTK_CONTAINER (object), GTK_WIDGET (child));
 
   if (glade_widget_superuser () == FALSE)
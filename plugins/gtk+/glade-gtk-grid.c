@@ -79,32 +79,12 @@ glade_gtk_grid_get_child_attachments (GtkWidget            *grid,
                            NULL);
 }
 
-static gboolean
-glade_gtk_grid_has_child (GtkGrid *grid,
-                          GList   *children,
-                          guint    left_attach,
-                          guint    top_attach)
-{
-  gboolean ret = FALSE;
-  GList *list;
-
-  for (list = children; list && list->data; list = list->next)
-    {
-      GladeGridAttachments attach;
-      GtkWidget *widget = list->data;
-
-      glade_gtk_grid_get_child_attachments (GTK_WIDGET (grid), widget, &attach);
-
-      if (left_attach >= attach.left_attach && left_attach < attach.left_attach + attach.width && 
-          top_attach  >= attach.top_attach  && top_attach  < attach.top_attach  + attach.height)
-        {
-          ret = TRUE;
-          break;
-        }
-    }
-
-  return ret;
-}
+/* Cell states in the occupancy map built by refresh_placeholders() */
+enum {
+  CELL_FREE,
+  CELL_OCCUPIED,
+  CELL_PLACEHOLDER
+};
 
 static void
 glade_gtk_grid_refresh_placeholders (GtkGrid *grid,
@@ -115,6 +95,7 @@ glade_gtk_grid_refresh_placeholders (GtkGrid *grid,
   GtkContainer *container;
   GList *list, *children;
   guint n_columns, n_rows;
+  guint8 *cells;
   gint i, j;
 
   widget = glade_widget_get_from_gobject (grid);
@@ -130,24 +111,57 @@ glade_gtk_grid_refresh_placeholders (GtkGrid *grid,
   container = GTK_CONTAINER (grid);
   children = gtk_container_get_children (container);
 
+  /* Mark every cell covered by a widget, in a single pass over the children */
+  cells = g_new0 (guint8, n_columns * n_rows);
+
   for (list = children; list && list->data; list = list->next)
     {
+      GladeGridAttachments attach;
       GtkWidget *child = list->data;
+
       if (GLADE_IS_PLACEHOLDER (child))
+        continue;
+
+      glade_gtk_grid_get_child_attachments (GTK_WIDGET (grid), child, &attach);
+
+      for (i = MAX (attach.left_attach, 0);
+           i < MIN (attach.left_attach + attach.width, (gint) n_columns); i++)
+        for (j = MAX (attach.top_attach, 0);
+             j < MIN (attach.top_attach + attach.height, (gint) n_rows); j++)
+          cells[j * n_columns + i] = CELL_OCCUPIED;
+    }
+
+  /* Keep the placeholders still sitting alone on a free cell, drop the rest */
+  for (list = children; list && list->data; list = list->next)
+    {
+      GladeGridAttachments attach;
+      GtkWidget *child = list->data;
+
+      if (!GLADE_IS_PLACEHOLDER (child))
+        continue;
+
+      glade_gtk_grid_get_child_attachments (GTK_WIDGET (grid), child, &attach);
+
+      if (attach.width == 1 && attach.height == 1 &&
+          attach.left_attach >= 0 && attach.left_attach < (gint) n_columns &&
+          attach.top_attach  >= 0 && attach.top_attach  < (gint) n_rows &&
+          cells[attach.top_attach * n_columns + attach.left_attach] == CELL_FREE)
+        cells[attach.top_attach * n_columns + attach.left_attach] = CELL_PLACEHOLDER;
+      else
         gtk_container_remove (container, child);
     }
   g_list_free (children);
 
-  children = gtk_container_get_children (container);
-
+  /* Fill in the cells that just became free */
   for (i = 0; i < n_columns; i++)
     for (j = 0; j < n_rows; j++)
-      if (glade_gtk_grid_has_child (grid, children, i, j) == FALSE)
+      if (cells[j * n_columns + i] == CELL_FREE)
         gtk_grid_attach (grid, glade_placeholder_new (), i, j, 1, 1);
 
+  g_free (cells);
+
   if (gtk_widget_get_realized (GTK_WIDGET (grid)))
     gtk_container_check_resize (container);
-  g_list_free (children);
 }
 
 static void
@@ -134,14 +134,15 @@ glade_gtk_parse_atk_relation (GladeProperty *property, GladeXmlNode *node)
 
   /* we must synchronize this directly after loading this project
    * (i.e. lookup the actual objects after they've been parsed and
-   * are present). this is a feature of object and object list properties
-   * that needs a better api.
+   * are present).
    */
   if (string)
     {
-      g_object_set_data_full (G_OBJECT (property), "glade-loaded-object",
-                              /* 'string' here is already allocated on the heap */
-                              string, g_free);
+      GladeWidget *widget = glade_property_get_widget (property);
+
+      glade_project_queue_object_reference (glade_widget_get_project (widget),
+                                            property, string);
+      g_free (string);
     }
 }
 
@@ -44,6 +44,10 @@ struct _GladePreferencesPrivate
   GtkWidget *deprecations_toggle;
   GtkWidget *unrecognized_toggle;
 
+  GtkWidget *undo_levels_spin;
+  GtkWidget *undo_memory_spin;
+  GtkWidget *undo_compaction_toggle;
+
   GladeSettings *settings;
 };
 
@@ -166,6 +170,9 @@ glade_preferences_set_settings (GladePreferences *self,
                                glade_preferences_transform_to, glade_preferences_transform_from, (void *)GLADE_VERIFY_DEPRECATIONS, NULL);
   g_object_bind_property_full (settings, "verify-flags", self->priv->unrecognized_toggle, "active", G_BINDING_BIDIRECTIONAL | G_BINDING_SYNC_CREATE,
                                glade_preferences_transform_to, glade_preferences_transform_from, (void *)GLADE_VERIFY_UNRECOGNIZED, NULL);
+  g_object_bind_property (settings, "undo-levels", self->priv->undo_levels_spin, "value", G_BINDING_BIDIRECTIONAL | G_BINDING_SYNC_CREATE);
+  g_object_bind_property (settings, "undo-memory", self->priv->undo_memory_spin, "value", G_BINDING_BIDIRECTIONAL | G_BINDING_SYNC_CREATE);
+  g_object_bind_property (settings, "undo-compaction", self->priv->undo_compaction_toggle, "active", G_BINDING_BIDIRECTIONAL | G_BINDING_SYNC_CREATE);
 
   paths = glade_catalog_get_extra_paths ();
   gtk_list_store_clear (GTK_LIST_STORE (self->priv->catalog_path_store));
@@ -318,6 +325,9 @@ glade_preferences_class_init (GladePreferencesClass *klass)
   gtk_widget_class_bind_template_child_private (widget_class, GladePreferences, versioning_toggle);
   gtk_widget_class_bind_template_child_private (widget_class, GladePreferences, deprecations_toggle);
   gtk_widget_class_bind_template_child_private (widget_class, GladePreferences, unrecognized_toggle);
+  gtk_widget_class_bind_template_child_private (widget_class, GladePreferences, undo_levels_spin);
+  gtk_widget_class_bind_template_child_private (widget_class, GladePreferences, undo_memory_spin);
+  gtk_widget_class_bind_template_child_private (widget_class, GladePreferences, undo_compaction_toggle);
 
   /* Declare the callback ports that this widget class exposes, to bind with <signal>
    * connections defined in the GtkBuilder xml
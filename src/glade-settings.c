@@ -33,6 +33,11 @@
 #define CONFIG_KEY_AUTOSAVE         "autosave"
 #define CONFIG_KEY_AUTOSAVE_SECONDS "autosave-seconds"
 
+#define CONFIG_GROUP_UNDO           "Undo History"
+#define CONFIG_KEY_UNDO_LEVELS      "levels"
+#define CONFIG_KEY_UNDO_MEMORY      "memory"
+#define CONFIG_KEY_UNDO_COMPACTION  "compaction"
+
 #define CONFIG_GROUP_SAVE_WARNINGS  "Save Warnings"
 #define CONFIG_KEY_VERSIONING       "versioning"
 #define CONFIG_KEY_DEPRECATIONS     "deprecations"
@@ -45,6 +50,9 @@ struct _GladeSettings
   gboolean backup;
   gboolean autosave;
   gint autosave_seconds;
+  gint undo_levels;
+  gint undo_memory;
+  gboolean undo_compaction;
   GladeVerifyFlags flags;
 };
 
@@ -53,6 +61,9 @@ enum
   PROP_BACKUP = 1,
   PROP_AUTOSAVE,
   PROP_AUTOSAVE_SECONDS,
+  PROP_UNDO_LEVELS,
+  PROP_UNDO_MEMORY,
+  PROP_UNDO_COMPACTION,
   PROP_VERIFY_FLAGS,
   N_PROPERTIES
 };
@@ -83,6 +94,18 @@ glade_settings_set_property (GObject      *object,
       self->autosave_seconds = g_value_get_int (value);
       break;
 
+    case PROP_UNDO_LEVELS:
+      self->undo_levels = g_value_get_int (value);
+      break;
+
+    case PROP_UNDO_MEMORY:
+      self->undo_memory = g_value_get_int (value);
+      break;
+
+    case PROP_UNDO_COMPACTION:
+      self->undo_compaction = g_value_get_boolean (value);
+      break;
+
     case PROP_VERIFY_FLAGS:
       self->flags = g_value_get_flags (value);
       break;
@@ -115,6 +138,18 @@ glade_settings_get_property (GObject    *object,
       g_value_set_int (value, self->autosave_seconds);
       break;
 
+    case PROP_UNDO_LEVELS:
+      g_value_set_int (value, self->undo_levels);
+      break;
+
+    case PROP_UNDO_MEMORY:
+      g_value_set_int (value, self->undo_memory);
+      break;
+
+    case PROP_UNDO_COMPACTION:
+      g_value_set_boolean (value, self->undo_compaction);
+      break;
+
     case PROP_VERIFY_FLAGS:
       g_value_set_flags (value, self->flags);
       break;
@@ -154,6 +189,27 @@ glade_settings_class_init (GladeSettingsClass *klass)
                       G_MININT, G_MAXINT, 5,
                       G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS);
 
+  obj_properties[PROP_UNDO_LEVELS] =
+    g_param_spec_int ("undo-levels",
+                      "Undo Levels",
+                      "Maximum amount of commands kept in the undo history, 0 for no limit.",
+                      0, G_MAXINT, 1000,
+                      G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS);
+
+  obj_properties[PROP_UNDO_MEMORY] =
+    g_param_spec_int ("undo-memory",
+                      "Undo Memory",
+                      "Maximum memory in megabytes used by the undo history, 0 for no limit.",
+                      0, G_MAXINT, 128,
+                      G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS);
+
+  obj_properties[PROP_UNDO_COMPACTION] =
+    g_param_spec_boolean ("undo-compaction",
+                          "Undo Compaction",
+                          "Merge consecutive changes to the same property in the older undo history.",
+                          FALSE,
+                          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS);
+
   obj_properties[PROP_VERIFY_FLAGS] =
     g_param_spec_flags ("verify-flags",
                         "Verify flags",
@@ -173,6 +229,9 @@ glade_settings_init (GladeSettings *self)
   self->backup = TRUE;
   self->autosave = TRUE;
   self->autosave_seconds = 5;
+  self->undo_levels = 1000;
+  self->undo_memory = 128;
+  self->undo_compaction = FALSE;
   self->flags = GLADE_VERIFY_VERSIONS | GLADE_VERIFY_UNRECOGNIZED;
 }
 
@@ -211,6 +270,13 @@ glade_settings_save (GladeSettings *self,
   g_key_file_set_integer (file, CONFIG_GROUP_LOAD_SAVE, CONFIG_KEY_AUTOSAVE_SECONDS,
                           self->autosave_seconds);
 
+  g_key_file_set_integer (file, CONFIG_GROUP_UNDO, CONFIG_KEY_UNDO_LEVELS,
+                          self->undo_levels);
+  g_key_file_set_integer (file, CONFIG_GROUP_UNDO, CONFIG_KEY_UNDO_MEMORY,
+                          self->undo_memory);
+  g_key_file_set_boolean (file, CONFIG_GROUP_UNDO, CONFIG_KEY_UNDO_COMPACTION,
+                          self->undo_compaction);
+
   g_key_file_set_boolean (file, CONFIG_GROUP_SAVE_WARNINGS, CONFIG_KEY_VERSIONING,
                           self->flags & GLADE_VERIFY_VERSIONS);
   g_key_file_set_boolean (file, CONFIG_GROUP_SAVE_WARNINGS, CONFIG_KEY_DEPRECATIONS,
@@ -258,6 +324,16 @@ glade_settings_load (GladeSettings *self,
   if (g_key_file_has_key (file, CONFIG_GROUP_LOAD_SAVE, CONFIG_KEY_AUTOSAVE_SECONDS, NULL))
     self->autosave_seconds = g_key_file_get_integer (file, CONFIG_GROUP_LOAD_SAVE, CONFIG_KEY_AUTOSAVE_SECONDS, NULL);
 
+  /* Undo history */
+  if (g_key_file_has_key (file, CONFIG_GROUP_UNDO, CONFIG_KEY_UNDO_LEVELS, NULL))
+    self->undo_levels = MAX (0, g_key_file_get_integer (file, CONFIG_GROUP_UNDO, CONFIG_KEY_UNDO_LEVELS, NULL));
+
+  if (g_key_file_has_key (file, CONFIG_GROUP_UNDO, CONFIG_KEY_UNDO_MEMORY, NULL))
+    self->undo_memory = MAX (0, g_key_file_get_integer (file, CONFIG_GROUP_UNDO, CONFIG_KEY_UNDO_MEMORY, NULL));
+
+  if (g_key_file_has_key (file, CONFIG_GROUP_UNDO, CONFIG_KEY_UNDO_COMPACTION, NULL))
+    self->undo_compaction = g_key_file_get_boolean (file, CONFIG_GROUP_UNDO, CONFIG_KEY_UNDO_COMPACTION, NULL);
+
   /* Warnings */
   if (g_key_file_has_key (file, CONFIG_GROUP_SAVE_WARNINGS, CONFIG_KEY_VERSIONING, NULL))
     {
@@ -308,6 +384,30 @@ glade_settings_autosave_seconds (GladeSettings *self)
   return self->autosave_seconds;
 }
 
+gint
+glade_settings_undo_levels (GladeSettings *self)
+{
+  g_return_val_if_fail (GLADE_IS_SETTINGS (self), 0);
+
+  return self->undo_levels;
+}
+
+gint
+glade_settings_undo_memory (GladeSettings *self)
+{
+  g_return_val_if_fail (GLADE_IS_SETTINGS (self), 0);
+
+  return self->undo_memory;
+}
+
+gboolean
+glade_settings_undo_compaction (GladeSettings *self)
+{
+  g_return_val_if_fail (GLADE_IS_SETTINGS (self), FALSE);
+
+  return self->undo_compaction;
+}
+
 GladeVerifyFlags
 glade_settings_get_verify_flags (GladeSettings *self)
 {
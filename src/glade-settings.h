@@ -39,6 +39,9 @@ void             glade_settings_load             (GladeSettings *self,
 gboolean         glade_settings_backup           (GladeSettings *self);
 gboolean         glade_settings_autosave         (GladeSettings *self);
 gint             glade_settings_autosave_seconds (GladeSettings *self);
+gint             glade_settings_undo_levels      (GladeSettings *self);
+gint             glade_settings_undo_memory      (GladeSettings *self);
+gboolean         glade_settings_undo_compaction  (GladeSettings *self);
 GladeVerifyFlags glade_settings_get_verify_flags (GladeSettings *self);
 
 G_END_DECLS
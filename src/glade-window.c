@@ -445,16 +445,16 @@ cancel_autosave (gpointer data)
   g_source_remove (autosave_id);
 }
 
-static gboolean
-autosave_project (gpointer data)
+static void
+project_autosaved_cb (GladeProject *project,
+                      const GError *error,
+                      GladeWindow  *window)
 {
-  GladeProject *project = (GladeProject *)data;
-  GladeWindow *window = GLADE_WINDOW (glade_app_get_window ());
   gchar *display_name;
 
   display_name = glade_project_get_name (project);
 
-  if (glade_project_autosave (project, NULL))
+  if (error == NULL)
     glade_util_flash_message (window->priv->statusbar,
                               window->priv->statusbar_actions_context_id,
                               _("Autosaving '%s'"), display_name);
@@ -465,6 +465,15 @@ autosave_project (gpointer data)
                               _("Error autosaving '%s'"), display_name);
 
   g_free (display_name);
+}
+
+static gboolean
+autosave_project (gpointer data)
+{
+  GladeProject *project = (GladeProject *)data;
+
+  /* The snapshot is written in a worker thread, see project_autosaved_cb() */
+  glade_project_queue_autosave (project);
 
   /* This will remove the source id */
   g_object_set_data (G_OBJECT (project), "glade-autosave-id", NULL);
@@ -489,6 +498,28 @@ project_queue_autosave (GladeWindow *window, GladeProject *project)
       g_object_set_data (G_OBJECT (project), "glade-autosave-id", NULL);
 }
 
+static void
+project_apply_undo_settings (GladeWindow *window, GladeProject *project)
+{
+  GladeSettings *settings = window->priv->settings;
+
+  glade_project_set_undo_limits (project,
+                                 glade_settings_undo_levels (settings),
+                                 (gsize) glade_settings_undo_memory (settings) * 1024 * 1024);
+  glade_project_set_undo_compaction (project, glade_settings_undo_compaction (settings));
+}
+
+static void
+on_undo_settings_changed (GladeSettings *settings,
+                          GParamSpec    *pspec,
+                          GladeWindow   *window)
+{
+  GList *l;
+
+  for (l = glade_app_get_projects (); l; l = l->next)
+    project_apply_undo_settings (window, l->data);
+}
+
 static void
 project_cancel_autosave (GladeProject *project)
 {
@@ -1140,6 +1171,7 @@ close_project (GladeWindow *window, GladeProject *project)
   g_signal_handlers_disconnect_by_func (project, project_selection_changed_cb, window);
   g_signal_handlers_disconnect_by_func (project, project_targets_changed_cb, window);
   g_signal_handlers_disconnect_by_func (project, project_changed_cb, window);
+  g_signal_handlers_disconnect_by_func (project, project_autosaved_cb, window);
   g_signal_handlers_disconnect_by_func (project, on_pointer_mode_changed, window);
 
   /* remove inspector first */
@@ -1556,6 +1588,10 @@ add_project (GladeWindow *window, GladeProject *project, gboolean for_file)
                     G_CALLBACK (project_targets_changed_cb), window);
   g_signal_connect (G_OBJECT (project), "changed",
                     G_CALLBACK (project_changed_cb), window);
+  g_signal_connect (G_OBJECT (project), "autosaved",
+                    G_CALLBACK (project_autosaved_cb), window);
+
+  project_apply_undo_settings (window, project);
 
   /* create inspector */
   inspector = glade_inspector_new ();
@@ -2087,6 +2123,13 @@ glade_window_init (GladeWindow *window)
   priv->settings = glade_settings_new ();
   glade_settings_load (priv->settings, glade_app_get_config ());
 
+  g_signal_connect (priv->settings, "notify::undo-levels",
+                    G_CALLBACK (on_undo_settings_changed), window);
+  g_signal_connect (priv->settings, "notify::undo-memory",
+                    G_CALLBACK (on_undo_settings_changed), window);
+  g_signal_connect (priv->settings, "notify::undo-compaction",
+                    G_CALLBACK (on_undo_settings_changed), window);
+
   /* Create GladeApp singleton, this will load all catalogs and load icons */
   priv->app = glade_app_new ();
 
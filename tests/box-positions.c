@@ -0,0 +1,165 @@
+#include <glib.h>
+#include <glib-object.h>
+
+#include <gladeui/glade-app.h>
+
+#include "test-utils.h"
+
+#define N_LABELS 6
+
+/* A box whose children are written in the opposite order of their positions */
+static GladeProject *
+load_project (guint n_labels)
+{
+  GladeProject *project;
+  GString *xml;
+  guint i;
+
+  xml = g_string_new (TEST_UTILS_UI_HEADER
+                      "  <object class=\"GtkBox\" id=\"box\">\n");
+
+  for (i = n_labels; i > 0; i--)
+    g_string_append_printf (xml,
+                            "    <child>\n"
+                            "      <object class=\"GtkLabel\" id=\"label%u\"/>\n"
+                            "      <packing>\n"
+                            "        <property name=\"position\">%u</property>\n"
+                            "      </packing>\n"
+                            "    </child>\n",
+                            i - 1, i - 1);
+
+  g_string_append (xml, "  </object>\n" TEST_UTILS_UI_FOOTER);
+
+  project = test_utils_load_project (xml->str);
+  g_string_free (xml, TRUE);
+
+  return project;
+}
+
+static gint
+get_position (GladeProject *project, const gchar *name)
+{
+  GladeWidget *widget = glade_project_get_widget_by_name (project, name);
+  gint position;
+
+  glade_widget_pack_property_get (widget, "position", &position);
+
+  return position;
+}
+
+/* Every child sits in the box where its position says */
+static void
+assert_order (GladeProject *project)
+{
+  GladeWidget *gbox = glade_project_get_widget_by_name (project, "box");
+  GtkContainer *box = GTK_CONTAINER (glade_widget_get_object (gbox));
+  GList *list, *children;
+  gint index;
+
+  children = gtk_container_get_children (box);
+
+  for (list = children, index = 0; list; list = list->next, index++)
+    {
+      GladeWidget *gchild = glade_widget_get_from_gobject (list->data);
+      gint position;
+
+      g_assert_nonnull (gchild);
+      glade_widget_pack_property_get (gchild, "position", &position);
+      g_assert_cmpint (position, ==, index);
+    }
+
+  g_list_free (children);
+}
+
+static void
+test_load (void)
+{
+  GladeProject *project;
+
+  g_test_log_set_fatal_handler (test_utils_ignore_gvfs_warning, NULL);
+
+  project = load_project (N_LABELS);
+  assert_order (project);
+  g_assert_cmpint (get_position (project, "label0"), ==, 0);
+  g_assert_cmpint (get_position (project, "label5"), ==, 5);
+
+  g_object_unref (project);
+}
+
+static void
+test_group (void)
+{
+  GladeWidget *label0, *label3;
+  GladeProject *project;
+
+  g_test_log_set_fatal_handler (test_utils_ignore_gvfs_warning, NULL);
+
+  project = load_project (N_LABELS);
+  label0 = glade_project_get_widget_by_name (project, "label0");
+  label3 = glade_project_get_widget_by_name (project, "label3");
+
+  /* Moving a child swaps it with the one at its new position */
+  glade_command_push_group ("Move labels");
+  glade_command_set_property (glade_widget_get_pack_property (label0, "position"), 3);
+  glade_command_set_property (glade_widget_get_pack_property (label3, "position"), 5);
+  glade_command_pop_group ();
+
+  assert_order (project);
+  g_assert_cmpint (get_position (project, "label0"), ==, 3);
+  g_assert_cmpint (get_position (project, "label3"), ==, 5);
+  g_assert_cmpint (get_position (project, "label5"), ==, 0);
+
+  /* Undo restores the positions both commands changed */
+  glade_project_undo (project);
+  assert_order (project);
+  g_assert_cmpint (get_position (project, "label0"), ==, 0);
+  g_assert_cmpint (get_position (project, "label3"), ==, 3);
+  g_assert_cmpint (get_position (project, "label5"), ==, 5);
+
+  glade_project_redo (project);
+  assert_order (project);
+  g_assert_cmpint (get_position (project, "label0"), ==, 3);
+  g_assert_cmpint (get_position (project, "label3"), ==, 5);
+  g_assert_cmpint (get_position (project, "label5"), ==, 0);
+
+  g_object_unref (project);
+}
+
+/* Loads a box with @data children */
+static void
+test_load_time (gconstpointer data)
+{
+  guint n_labels = GPOINTER_TO_UINT (data);
+  GladeProject *project;
+  gdouble elapsed;
+
+  g_test_log_set_fatal_handler (test_utils_ignore_gvfs_warning, NULL);
+
+  g_test_timer_start ();
+  project = load_project (n_labels);
+  elapsed = g_test_timer_elapsed ();
+
+  g_test_minimized_result (elapsed, "Loaded a box with %u children in %.3f seconds",
+                           n_labels, elapsed);
+  assert_order (project);
+
+  g_object_unref (project);
+}
+
+int
+main (int argc, char *argv[])
+{
+  gtk_test_init (&argc, &argv, NULL);
+
+  glade_init ();
+  glade_app_get ();
+
+  g_test_add_func ("/BoxPositions/Load", test_load);
+  g_test_add_func ("/BoxPositions/Group", test_group);
+
+  /* Benchmarks, run with -m perf */
+  if (g_test_perf ())
+    g_test_add_data_func ("/BoxPositions/Time/1000", GUINT_TO_POINTER (1000), test_load_time);
+
+  return g_test_run ();
+}
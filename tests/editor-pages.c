@@ -0,0 +1,140 @@
+#include <glib.h>
+#include <glib-object.h>
+
+#include <gladeui/glade-app.h>
+#include <gladeui/glade-private.h>
+
+#include "test-utils.h"
+
+static void
+find_notebook (GtkWidget *widget, gpointer data)
+{
+  GtkWidget **notebook = data;
+
+  if (*notebook)
+    return;
+
+  if (GTK_IS_NOTEBOOK (widget))
+    *notebook = widget;
+  else if (GTK_IS_CONTAINER (widget))
+    gtk_container_forall (GTK_CONTAINER (widget), find_notebook, data);
+}
+
+static GtkNotebook *
+get_notebook (GladeEditor *editor)
+{
+  GtkWidget *notebook = NULL;
+
+  gtk_container_forall (GTK_CONTAINER (editor), find_notebook, &notebook);
+  g_assert_nonnull (notebook);
+
+  return GTK_NOTEBOOK (notebook);
+}
+
+static void
+load (GladeEditor *editor, GladeProject *project, const gchar *name)
+{
+  glade_editor_load_widget (editor, glade_project_get_widget_by_name (project, name));
+}
+
+static void
+test_pages (void)
+{
+  GtkWidget *general, *common, *packing;
+  GladeProject *project;
+  GladeEditor *editor;
+
+  g_test_log_set_fatal_handler (test_utils_ignore_gvfs_warning, NULL);
+
+  project = test_utils_load_box (2, 1);
+  editor = g_object_ref_sink (glade_editor_new ());
+
+  /* Only the page in view is loaded */
+  load (editor, project, "label0");
+  g_assert_nonnull ((general = _glade_editor_get_page_editable (editor, GLADE_PAGE_GENERAL)));
+  g_assert_null (_glade_editor_get_page_editable (editor, GLADE_PAGE_COMMON));
+  g_assert_null (_glade_editor_get_page_editable (editor, GLADE_PAGE_PACKING));
+
+  /* Widgets of the same class share their editables */
+  load (editor, project, "label1");
+  g_assert_true (_glade_editor_get_page_editable (editor, GLADE_PAGE_GENERAL) == general);
+
+  /* Other pages are loaded once switched to */
+  gtk_notebook_set_current_page (get_notebook (editor), 2);
+  g_assert_nonnull ((common = _glade_editor_get_page_editable (editor, GLADE_PAGE_COMMON)));
+  g_assert_true (glade_editable_loaded_widget (GLADE_EDITABLE (common)) ==
+                 glade_project_get_widget_by_name (project, "label1"));
+
+  gtk_notebook_set_current_page (get_notebook (editor), 1);
+  g_assert_nonnull ((packing = _glade_editor_get_page_editable (editor, GLADE_PAGE_PACKING)));
+
+  /* Another class gets its own editables, but the pool keeps the old ones */
+  load (editor, project, "button0");
+  g_assert_null (_glade_editor_get_page_editable (editor, GLADE_PAGE_GENERAL));
+  g_assert_true (_glade_editor_get_page_editable (editor, GLADE_PAGE_PACKING) != packing);
+
+  load (editor, project, "label0");
+  g_assert_true (_glade_editor_get_page_editable (editor, GLADE_PAGE_PACKING) == packing);
+  g_assert_true (glade_editable_loaded_widget (GLADE_EDITABLE (packing)) ==
+                 glade_project_get_widget_by_name (project, "label0"));
+
+  gtk_notebook_set_current_page (get_notebook (editor), 0);
+  g_assert_true (_glade_editor_get_page_editable (editor, GLADE_PAGE_GENERAL) == general);
+
+  /* Toplevels have no packing page */
+  gtk_notebook_set_current_page (get_notebook (editor), 1);
+  load (editor, project, "box");
+  g_assert_null (_glade_editor_get_page_editable (editor, GLADE_PAGE_PACKING));
+
+  glade_editor_load_widget (editor, NULL);
+  g_assert_null (_glade_editor_get_page_editable (editor, GLADE_PAGE_GENERAL));
+
+  gtk_widget_destroy (GTK_WIDGET (editor));
+  g_object_unref (editor);
+  g_object_unref (project);
+}
+
+/* Selects every widget of a project with @data widgets, one after the other */
+static void
+test_select_time (gconstpointer data)
+{
+  guint n_widgets = GPOINTER_TO_UINT (data);
+  GladeProject *project;
+  GladeEditor *editor;
+  gdouble elapsed;
+  GList *l;
+
+  g_test_log_set_fatal_handler (test_utils_ignore_gvfs_warning, NULL);
+
+  project = test_utils_load_box (n_widgets / 2, n_widgets / 2);
+  editor = g_object_ref_sink (glade_editor_new ());
+
+  g_test_timer_start ();
+
+  for (l = glade_project_get_objects (project); l; l = g_list_next (l))
+    glade_editor_load_widget (editor, glade_widget_get_from_gobject (l->data));
+
+  elapsed = g_test_timer_elapsed ();
+  g_test_minimized_result (elapsed, "Selected %u widgets in %.3f seconds", n_widgets, elapsed);
+
+  gtk_widget_destroy (GTK_WIDGET (editor));
+  g_object_unref (editor);
+  g_object_unref (project);
+}
+
+int
+main (int argc, char *argv[])
+{
+  gtk_test_init (&argc, &argv, NULL);
+
+  glade_init ();
+  glade_app_get ();
+
+  g_test_add_func ("/EditorPages/Pages", test_pages);
+
+  /* Benchmarks, run with -m perf */
+  if (g_test_perf ())
+    g_test_add_data_func ("/EditorPages/Time/1000", GUINT_TO_POINTER (1000), test_select_time);
+
+  return g_test_run ();
+}
@@ -0,0 +1,239 @@
+#include <glib.h>
+#include <glib-object.h>
+
+#include <gladeui/glade-app.h>
+
+#include "test-utils.h"
+
+static void
+get_attachments (GtkWidget *grid, GtkWidget *child,
+                 gint *left, gint *top, gint *width, gint *height)
+{
+  gtk_container_child_get (GTK_CONTAINER (grid), child,
+                           "left-attach", left,
+                           "top-attach",  top,
+                           "width",       width,
+                           "height",      height,
+                           NULL);
+}
+
+/* The layout the grid adaptor always produced, by checking every cell
+ * against every widget: exactly one 1x1 placeholder on each cell no widget
+ * covers, and nothing else.
+ */
+static void
+assert_placeholders (GladeProject *project, const gchar *name)
+{
+  GladeWidget *gwidget = glade_project_get_widget_by_name (project, name);
+  GtkWidget *grid = GTK_WIDGET (glade_widget_get_object (gwidget));
+  GList *list, *children;
+  guint n_columns, n_rows, n_placeholders = 0, n_free = 0;
+  gint i, j;
+
+  glade_widget_property_get (gwidget, "n-columns", &n_columns);
+  glade_widget_property_get (gwidget, "n-rows", &n_rows);
+
+  children = gtk_container_get_children (GTK_CONTAINER (grid));
+
+  for (i = 0; i < (gint) n_columns; i++)
+    for (j = 0; j < (gint) n_rows; j++)
+      {
+        guint n_widgets = 0, n_cell_placeholders = 0;
+
+        for (list = children; list; list = list->next)
+          {
+            gint left, top, width, height;
+
+            get_attachments (grid, list->data, &left, &top, &width, &height);
+
+            if (i >= left && i < left + width && j >= top && j < top + height)
+              {
+                if (GLADE_IS_PLACEHOLDER (list->data))
+                  n_cell_placeholders++;
+                else
+                  n_widgets++;
+              }
+          }
+
+        if (n_widgets)
+          g_assert_cmpuint (n_cell_placeholders, ==, 0);
+        else
+          {
+            g_assert_cmpuint (n_cell_placeholders, ==, 1);
+            n_free++;
+          }
+      }
+
+  for (list = children; list; list = list->next)
+    {
+      gint left, top, width, height;
+
+      if (!GLADE_IS_PLACEHOLDER (list->data))
+        continue;
+
+      get_attachments (grid, list->data, &left, &top, &width, &height);
+      g_assert_cmpint (width, ==, 1);
+      g_assert_cmpint (height, ==, 1);
+      n_placeholders++;
+    }
+
+  /* No placeholder was left outside of the grid */
+  g_assert_cmpuint (n_placeholders, ==, n_free);
+
+  g_list_free (children);
+}
+
+static void
+set_pack_property (GladeProject *project, const gchar *name, const gchar *id, gint value)
+{
+  GladeWidget *widget = glade_project_get_widget_by_name (project, name);
+
+  glade_command_set_property (glade_widget_get_pack_property (widget, id), value);
+}
+
+static void
+set_property (GladeProject *project, const gchar *name, const gchar *id, guint value)
+{
+  GladeWidget *widget = glade_project_get_widget_by_name (project, name);
+
+  glade_command_set_property (glade_widget_get_property (widget, id), value);
+}
+
+static void
+test_layout (void)
+{
+  static const gchar xml[] =
+    "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+    "<interface>\n"
+    "  <requires lib=\"gtk+\" version=\"3.24\"/>\n"
+    "  <object class=\"GtkGrid\" id=\"grid\">\n"
+    "    <child>\n"
+    "      <object class=\"GtkLabel\" id=\"label0\"/>\n"
+    "      <packing>\n"
+    "        <property name=\"left_attach\">0</property>\n"
+    "        <property name=\"top_attach\">0</property>\n"
+    "        <property name=\"width\">2</property>\n"
+    "      </packing>\n"
+    "    </child>\n"
+    "    <child>\n"
+    "      <object class=\"GtkLabel\" id=\"label1\"/>\n"
+    "      <packing>\n"
+    "        <property name=\"left_attach\">2</property>\n"
+    "        <property name=\"top_attach\">1</property>\n"
+    "        <property name=\"height\">2</property>\n"
+    "      </packing>\n"
+    "    </child>\n"
+    "    <child>\n"
+    "      <placeholder/>\n"
+    "    </child>\n"
+    "  </object>\n"
+    "</interface>\n";
+  GladeProject *project;
+  GList *widgets;
+
+  g_test_log_set_fatal_handler (test_utils_ignore_gvfs_warning, NULL);
+
+  project = test_utils_load_project (xml);
+  assert_placeholders (project, "grid");
+
+  /* Moving and spanning widgets */
+  set_pack_property (project, "label0", "top-attach", 2);
+  assert_placeholders (project, "grid");
+  set_pack_property (project, "label1", "left-attach", 0);
+  assert_placeholders (project, "grid");
+  set_pack_property (project, "label1", "width", 3);
+  assert_placeholders (project, "grid");
+  set_pack_property (project, "label1", "height", 1);
+  assert_placeholders (project, "grid");
+
+  /* Growing and shrinking the grid */
+  set_property (project, "grid", "n-columns", 5);
+  assert_placeholders (project, "grid");
+  set_property (project, "grid", "n-rows", 6);
+  assert_placeholders (project, "grid");
+  set_property (project, "grid", "n-rows", 4);
+  assert_placeholders (project, "grid");
+  set_property (project, "grid", "n-columns", 3);
+  assert_placeholders (project, "grid");
+
+  /* Removing a widget and bringing it back */
+  widgets = g_list_prepend (NULL, glade_project_get_widget_by_name (project, "label1"));
+  glade_command_delete (widgets);
+  g_list_free (widgets);
+  assert_placeholders (project, "grid");
+
+  while (glade_project_next_undo_item (project))
+    {
+      glade_project_undo (project);
+      assert_placeholders (project, "grid");
+    }
+
+  while (glade_project_next_redo_item (project))
+    {
+      glade_project_redo (project);
+      assert_placeholders (project, "grid");
+    }
+
+  g_object_unref (project);
+}
+
+/* Moves a widget across a @data x @data grid */
+static void
+test_refresh_time (gconstpointer data)
+{
+  guint size = GPOINTER_TO_UINT (data);
+  GladeProject *project;
+  gdouble elapsed;
+  gchar *xml;
+  guint i;
+
+  g_test_log_set_fatal_handler (test_utils_ignore_gvfs_warning, NULL);
+
+  xml = g_strdup_printf ("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                         "<interface>\n"
+                         "  <requires lib=\"gtk+\" version=\"3.24\"/>\n"
+                         "  <object class=\"GtkGrid\" id=\"grid\">\n"
+                         "    <child>\n"
+                         "      <object class=\"GtkLabel\" id=\"label\"/>\n"
+                         "      <packing>\n"
+                         "        <property name=\"left_attach\">%u</property>\n"
+                         "        <property name=\"top_attach\">%u</property>\n"
+                         "      </packing>\n"
+                         "    </child>\n"
+                         "  </object>\n"
+                         "</interface>\n",
+                         size - 1, size - 1);
+  project = test_utils_load_project (xml);
+  g_free (xml);
+
+  g_test_timer_start ();
+
+  /* The grid is sized after the widget in the bottom right corner */
+  for (i = 1; i < size; i++)
+    set_pack_property (project, "label", "left-attach", size - 1 - i);
+
+  elapsed = g_test_timer_elapsed ();
+  g_test_minimized_result (elapsed, "Moved a widget across a %ux%u grid in %.3f seconds",
+                           size, size, elapsed);
+
+  assert_placeholders (project, "grid");
+
+  g_object_unref (project);
+}
+
+int
+main (int argc, char *argv[])
+{
+  gtk_test_init (&argc, &argv, NULL);
+
+  glade_init ();
+  glade_app_get ();
+
+  g_test_add_func ("/GridPlaceholders/Layout", test_layout);
+
+  /* Benchmarks, run with -m perf */
+  if (g_test_perf ())
+    g_test_add_data_func ("/GridPlaceholders/Time/60", GUINT_TO_POINTER (60), test_refresh_time);
+
+  return g_test_run ();
+}
@@ -0,0 +1,235 @@
+#include <string.h>
+
+#include <glib.h>
+#include <glib-object.h>
+
+#include <gladeui/glade-app.h>
+
+#include "test-utils.h"
+
+/* @n_boxes boxes, nested in one another, with @n_labels labels each */
+static GladeProject *
+load_project (guint n_boxes, guint n_labels)
+{
+  GladeProject *project;
+  GString *xml;
+  guint i, j;
+
+  xml = g_string_new (TEST_UTILS_UI_HEADER);
+
+  for (i = 0; i < n_boxes; i++)
+    {
+      g_string_append_printf (xml, "<object class=\"GtkBox\" id=\"box%u\">\n", i);
+
+      for (j = 0; j < n_labels; j++)
+        g_string_append_printf (xml,
+                                "<child><object class=\"GtkLabel\" id=\"label%u_%u\"/></child>\n",
+                                i, j);
+
+      if (i + 1 < n_boxes)
+        g_string_append (xml, "<child>\n");
+    }
+
+  for (i = 0; i < n_boxes; i++)
+    {
+      g_string_append (xml, "</object>\n");
+
+      if (i + 1 < n_boxes)
+        g_string_append (xml, "</child>\n");
+    }
+
+  g_string_append (xml, TEST_UTILS_UI_FOOTER);
+
+  project = test_utils_load_project (xml->str);
+  g_string_free (xml, TRUE);
+
+  return project;
+}
+
+static GtkWidget *
+get_entry (GtkWidget *inspector)
+{
+  GList *children = gtk_container_get_children (GTK_CONTAINER (inspector));
+  GtkWidget *entry = children->data;
+
+  g_assert_true (GTK_IS_ENTRY (entry));
+  g_list_free (children);
+
+  return entry;
+}
+
+static GtkTreeModel *
+get_filter (GtkWidget *inspector)
+{
+  GList *children = gtk_container_get_children (GTK_CONTAINER (inspector));
+  GtkWidget *view = gtk_bin_get_child (GTK_BIN (children->next->data));
+
+  g_list_free (children);
+
+  return gtk_tree_view_get_model (GTK_TREE_VIEW (view));
+}
+
+static gboolean
+quit_loop (gpointer loop)
+{
+  g_main_loop_quit (loop);
+  return G_SOURCE_REMOVE;
+}
+
+/* Types @text in the search entry and waits for the inspector to filter */
+static void
+search (GtkWidget *inspector, const gchar *text)
+{
+  GMainLoop *loop = g_main_loop_new (NULL, FALSE);
+
+  gtk_entry_set_text (GTK_ENTRY (get_entry (inspector)), text);
+
+  g_timeout_add (500, quit_loop, loop);
+  g_main_loop_run (loop);
+  g_main_loop_unref (loop);
+}
+
+/* Whether @iter or any of its children is named after @text */
+static gboolean
+matches (GtkTreeModel *model, GtkTreeIter *iter, const gchar *text)
+{
+  g_autoptr(GObject) object = NULL;
+  gchar *name_fold;
+  GtkTreeIter child;
+  gboolean retval;
+
+  if (gtk_tree_model_iter_children (model, &child, iter))
+    {
+      do
+        {
+          if (matches (model, &child, text))
+            return TRUE;
+        }
+      while (gtk_tree_model_iter_next (model, &child));
+    }
+
+  gtk_tree_model_get (model, iter, GLADE_PROJECT_MODEL_COLUMN_OBJECT, &object, -1);
+  name_fold = g_utf8_casefold (glade_widget_get_name (glade_widget_get_from_gobject (object)), -1);
+  retval = strstr (name_fold, text) != NULL;
+  g_free (name_fold);
+
+  return retval;
+}
+
+static void
+assert_rows (GtkTreeModel *filter, GtkTreeModel *model, GtkTreeIter *parent, const gchar *text)
+{
+  GtkTreeIter iter, filter_iter;
+
+  if (!gtk_tree_model_iter_children (model, &iter, parent))
+    return;
+
+  do
+    {
+      g_assert_cmpint (gtk_tree_model_filter_convert_child_iter_to_iter (GTK_TREE_MODEL_FILTER (filter),
+                                                                         &filter_iter, &iter),
+                       ==, matches (model, &iter, text));
+      assert_rows (filter, model, &iter, text);
+    }
+  while (gtk_tree_model_iter_next (model, &iter));
+}
+
+/* Rows show exactly when they or one of their children match @text */
+static void
+assert_search (GtkWidget *inspector, GladeProject *project, const gchar *text)
+{
+  gchar *text_fold = g_utf8_casefold (text, -1);
+
+  assert_rows (get_filter (inspector), GTK_TREE_MODEL (project), NULL, text_fold);
+  g_free (text_fold);
+}
+
+static void
+test_search (void)
+{
+  GladeProject *project;
+  GtkWidget *inspector;
+
+  g_test_log_set_fatal_handler (test_utils_ignore_gvfs_warning, NULL);
+
+  project = load_project (4, 3);
+  inspector = glade_inspector_new_with_project (project);
+  g_object_ref_sink (inspector);
+
+  search (inspector, "label2");
+  assert_search (inspector, project, "label2");
+
+  /* Extending the query */
+  search (inspector, "label2_1");
+  assert_search (inspector, project, "label2_1");
+
+  /* And going back to a broader one */
+  search (inspector, "BOX");
+  assert_search (inspector, project, "box");
+
+  search (inspector, "box3");
+  assert_search (inspector, project, "box3");
+
+  /* A renamed widget is found under its new name */
+  glade_command_set_name (glade_project_get_widget_by_name (project, "label0_0"), "box3_label");
+  search (inspector, "box3_");
+  assert_search (inspector, project, "box3_");
+
+  gtk_widget_destroy (inspector);
+  g_object_unref (inspector);
+  g_object_unref (project);
+}
+
+/* Searches a project with @data widgets, one keystroke at a time */
+static void
+test_search_time (gconstpointer data)
+{
+  guint n_widgets = GPOINTER_TO_UINT (data);
+  static const gchar query[] = "label99_";
+  GladeProject *project;
+  GtkWidget *inspector;
+  gdouble elapsed;
+  guint i;
+
+  g_test_log_set_fatal_handler (test_utils_ignore_gvfs_warning, NULL);
+
+  project = load_project (n_widgets / 50, 49);
+  inspector = glade_inspector_new_with_project (project);
+  g_object_ref_sink (inspector);
+
+  g_test_timer_start ();
+
+  for (i = 1; i <= strlen (query); i++)
+    {
+      gchar *text = g_strndup (query, i);
+      search (inspector, text);
+      g_free (text);
+    }
+
+  /* Leave out the time spent waiting for keystrokes */
+  elapsed = g_test_timer_elapsed () - strlen (query) * 0.5;
+  g_test_minimized_result (elapsed, "Searched %u widgets in %.3f seconds", n_widgets, elapsed);
+
+  assert_search (inspector, project, query);
+
+  gtk_widget_destroy (inspector);
+  g_object_unref (inspector);
+  g_object_unref (project);
+}
+
+int
+main (int argc, char *argv[])
+{
+  gtk_test_init (&argc, &argv, NULL);
+
+  glade_init ();
+  glade_app_get ();
+
+  g_test_add_func ("/InspectorSearch/Search", test_search);
+
+  /* Benchmarks, run with -m perf */
+  if (g_test_perf ())
+    g_test_add_data_func ("/InspectorSearch/Time/5000", GUINT_TO_POINTER (5000), test_search_time);
+
+  return g_test_run ();
+}
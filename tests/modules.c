@@ -3,6 +3,7 @@
 
 #include <gladeui/glade-app.h>
 #include <gladeui/glade-widget-adaptor.h>
+#include <gladeui/glade-private.h>
 
 static void
 test_object_class (gconstpointer data)
@@ -24,6 +25,32 @@ test_object_class (gconstpointer data)
   g_object_unref (widget);
 }
 
+static void
+test_deferred_catalogs (void)
+{
+  GladeCatalog *python = glade_app_get_catalog ("pythonplugin");
+  GladeCatalog *gjs = glade_app_get_catalog ("gjsplugin");
+
+  if (g_getenv (GLADE_ENV_EAGER_INIT))
+    {
+      g_test_skip ("Catalogs are loaded eagerly");
+      return;
+    }
+
+  /* Interpreters are not started until one of their classes is needed */
+  g_assert_true (_glade_catalog_is_deferred (python));
+  g_assert_true (_glade_catalog_is_deferred (gjs));
+  g_assert_false (_glade_catalog_is_deferred (glade_app_get_catalog ("gtk+")));
+
+  g_assert_nonnull (glade_widget_adaptor_get_by_name ("MyPythonBox"));
+  g_assert_false (_glade_catalog_is_deferred (python));
+  g_assert_true (_glade_catalog_is_deferred (gjs));
+
+  g_assert_nonnull (glade_catalog_get_adaptors (gjs));
+  g_assert_false (_glade_catalog_is_deferred (gjs));
+  g_assert_nonnull (glade_widget_adaptor_get_by_type (g_type_from_name ("MyJSGrid")));
+}
+
 int
 main (int argc, char *argv[])
 {
@@ -32,6 +59,7 @@ main (int argc, char *argv[])
   glade_init ();
   glade_app_get ();
 
+  g_test_add_func ("/Modules/Deferred", test_deferred_catalogs);
   g_test_add_data_func ("/Modules/Python", "MyPythonBox", test_object_class);
   g_test_add_data_func ("/Modules/JavaScript", "MyJSGrid", test_object_class);
 
@@ -0,0 +1,247 @@
+#include <string.h>
+
+#include <glib.h>
+#include <glib-object.h>
+
+#include <gladeui/glade-app.h>
+
+#include "test-utils.h"
+
+typedef struct
+{
+  guint add_widget;
+  guint remove_widget;
+  guint objects_changed;
+  guint selection_changed;
+  guint row_inserted;
+  guint added;
+  guint removed;
+} Counters;
+
+static void
+on_add_widget (GladeProject *project, GladeWidget *widget, Counters *counters)
+{
+  counters->add_widget++;
+}
+
+static void
+on_remove_widget (GladeProject *project, GladeWidget *widget, Counters *counters)
+{
+  counters->remove_widget++;
+}
+
+static void
+on_objects_changed (GladeProject *project,
+                    GPtrArray    *added,
+                    GPtrArray    *removed,
+                    Counters     *counters)
+{
+  counters->objects_changed++;
+  counters->added += added->len;
+  counters->removed += removed->len;
+}
+
+static void
+on_selection_changed (GladeProject *project, Counters *counters)
+{
+  counters->selection_changed++;
+}
+
+static void
+on_row_inserted (GtkTreeModel *model,
+                 GtkTreePath  *path,
+                 GtkTreeIter  *iter,
+                 Counters     *counters)
+{
+  counters->row_inserted++;
+}
+
+static void
+connect_counters (GladeProject *project, Counters *counters)
+{
+  g_signal_connect (project, "add-widget", G_CALLBACK (on_add_widget), counters);
+  g_signal_connect (project, "remove-widget", G_CALLBACK (on_remove_widget), counters);
+  g_signal_connect (project, "objects-changed", G_CALLBACK (on_objects_changed), counters);
+  g_signal_connect (project, "selection-changed", G_CALLBACK (on_selection_changed), counters);
+  g_signal_connect (project, "row-inserted", G_CALLBACK (on_row_inserted), counters);
+}
+
+/* A box with a button */
+static GObject *
+create_box (void)
+{
+  GladeWidget *box, *button;
+
+  box = glade_widget_adaptor_create_widget (glade_widget_adaptor_get_by_type (GTK_TYPE_BOX),
+                                            FALSE, NULL);
+  button = glade_widget_adaptor_create_widget (glade_widget_adaptor_get_by_type (GTK_TYPE_BUTTON),
+                                               FALSE, NULL);
+  glade_widget_add_child (box, button, FALSE);
+
+  return glade_widget_get_object (box);
+}
+
+static void
+test_bulk (void)
+{
+  Counters counters = { 0, };
+  GladeProject *project;
+  GObject *box0, *box1;
+
+  g_test_log_set_fatal_handler (test_utils_ignore_gvfs_warning, NULL);
+
+  project = glade_project_new ();
+  connect_counters (project, &counters);
+
+  box0 = create_box ();
+  box1 = create_box ();
+
+  glade_project_begin_bulk_update (project);
+  glade_project_add_object (project, box0);
+  glade_project_add_object (project, box1);
+  glade_project_selection_set (project, box1, TRUE);
+
+  /* Objects are in the project, notifications are held back */
+  g_assert_true (glade_project_has_object (project, box0));
+  g_assert_true (glade_project_has_object (project, box1));
+  g_assert_cmpuint (counters.add_widget, ==, 0);
+  g_assert_cmpuint (counters.objects_changed, ==, 0);
+  g_assert_cmpuint (counters.selection_changed, ==, 0);
+  g_assert_cmpuint (counters.row_inserted, ==, 0);
+
+  glade_project_end_bulk_update (project);
+
+  g_assert_cmpuint (counters.add_widget, ==, 4);
+  g_assert_cmpuint (counters.objects_changed, ==, 1);
+  g_assert_cmpuint (counters.added, ==, 4);
+  g_assert_cmpuint (counters.selection_changed, ==, 1);
+  g_assert_cmpuint (counters.row_inserted, ==, 4);
+  g_assert_cmpint (gtk_tree_model_iter_n_children (GTK_TREE_MODEL (project), NULL), ==, 2);
+
+  /* Widgets added and removed in the same bulk update are never heard of */
+  memset (&counters, 0, sizeof (Counters));
+  box0 = create_box ();
+
+  glade_project_begin_bulk_update (project);
+  glade_project_add_object (project, box0);
+  glade_project_remove_object (project, box0);
+  glade_project_end_bulk_update (project);
+
+  g_assert_false (glade_project_has_object (project, box0));
+  g_assert_cmpuint (counters.add_widget, ==, 0);
+  g_assert_cmpuint (counters.remove_widget, ==, 0);
+  g_assert_cmpuint (counters.objects_changed, ==, 0);
+  g_assert_cmpuint (counters.row_inserted, ==, 0);
+  g_assert_cmpint (gtk_tree_model_iter_n_children (GTK_TREE_MODEL (project), NULL), ==, 2);
+
+  /* Removing a single hierarchy is a bulk update of its own */
+  glade_project_remove_object (project, box1);
+  g_assert_cmpuint (counters.remove_widget, ==, 2);
+  g_assert_cmpuint (counters.objects_changed, ==, 1);
+  g_assert_cmpuint (counters.removed, ==, 2);
+  g_assert_cmpuint (counters.selection_changed, ==, 1);
+  g_assert_cmpint (gtk_tree_model_iter_n_children (GTK_TREE_MODEL (project), NULL), ==, 1);
+
+  g_object_unref (project);
+}
+
+static void
+test_commands (void)
+{
+  Counters counters = { 0, };
+  GladeProject *project;
+  GList *widgets = NULL;
+  GtkTreeIter iter;
+  guint i;
+
+  g_test_log_set_fatal_handler (test_utils_ignore_gvfs_warning, NULL);
+
+  project = test_utils_load_box (10, 0);
+  connect_counters (project, &counters);
+
+  for (i = 0; i < 10; i++)
+    {
+      gchar *name = g_strdup_printf ("label%u", i);
+      widgets = g_list_prepend (widgets, glade_project_get_widget_by_name (project, name));
+      g_free (name);
+    }
+
+  glade_command_delete (widgets);
+
+  g_assert_cmpuint (counters.remove_widget, ==, 10);
+  g_assert_cmpuint (counters.objects_changed, ==, 1);
+  g_assert_cmpuint (counters.removed, ==, 10);
+
+  /* Undo brings them back at once */
+  glade_project_undo (project);
+
+  g_assert_cmpuint (counters.add_widget, ==, 10);
+  g_assert_cmpuint (counters.objects_changed, ==, 2);
+  g_assert_cmpuint (counters.added, ==, 10);
+
+  g_assert_true (gtk_tree_model_get_iter_first (GTK_TREE_MODEL (project), &iter));
+  g_assert_cmpint (gtk_tree_model_iter_n_children (GTK_TREE_MODEL (project), &iter), ==, 10);
+
+  /* So does the whole group of commands of a cut */
+  memset (&counters, 0, sizeof (Counters));
+  glade_command_cut (widgets);
+
+  g_assert_cmpuint (counters.remove_widget, ==, 10);
+  g_assert_cmpuint (counters.objects_changed, ==, 1);
+
+  glade_project_undo (project);
+  g_assert_cmpuint (counters.objects_changed, ==, 2);
+  g_assert_cmpint (gtk_tree_model_iter_n_children (GTK_TREE_MODEL (project), &iter), ==, 10);
+
+  g_list_free (widgets);
+  g_object_unref (project);
+}
+
+/* Deletes and brings back @data labels */
+static void
+test_bulk_time (gconstpointer data)
+{
+  guint n_labels = GPOINTER_TO_UINT (data);
+  GladeProject *project;
+  GList *widgets = NULL;
+  const GList *l;
+  gdouble elapsed;
+
+  g_test_log_set_fatal_handler (test_utils_ignore_gvfs_warning, NULL);
+
+  project = test_utils_load_box (n_labels, 0);
+
+  for (l = glade_project_get_objects (project); l; l = g_list_next (l))
+    if (GTK_IS_LABEL (l->data))
+      widgets = g_list_prepend (widgets, glade_widget_get_from_gobject (l->data));
+
+  g_test_timer_start ();
+
+  glade_command_delete (widgets);
+  glade_project_undo (project);
+
+  elapsed = g_test_timer_elapsed ();
+  g_test_minimized_result (elapsed, "Deleted and restored %u labels in %.3f seconds",
+                           n_labels, elapsed);
+
+  g_list_free (widgets);
+  g_object_unref (project);
+}
+
+int
+main (int argc, char *argv[])
+{
+  gtk_test_init (&argc, &argv, NULL);
+
+  glade_init ();
+  glade_app_get ();
+
+  g_test_add_func ("/ProjectBulk/Bulk", test_bulk);
+  g_test_add_func ("/ProjectBulk/Commands", test_commands);
+
+  /* Benchmarks, run with -m perf */
+  if (g_test_perf ())
+    g_test_add_data_func ("/ProjectBulk/Time/2000", GUINT_TO_POINTER (2000), test_bulk_time);
+
+  return g_test_run ();
+}
@@ -0,0 +1,472 @@
+#include <glib.h>
+#include <glib/gstdio.h>
+#include <glib-object.h>
+
+#include <gladeui/glade-app.h>
+#include <gladeui/glade-private.h>
+
+#include "test-utils.h"
+
+/* Writes a synthetic project with @n_labels toplevel labels, each one
+ * referencing the previously declared label by its mnemonic-widget
+ * property, to a temporary file and returns its path.
+ */
+static gchar *
+write_synthetic_project (guint n_labels)
+{
+  GString *xml = g_string_new (TEST_UTILS_UI_HEADER);
+  gchar *path;
+  guint i;
+
+  for (i = 0; i < n_labels; i++)
+    {
+      g_string_append_printf (xml,
+                              "  <object class=\"GtkLabel\" id=\"label%u\">\n"
+                              "    <property name=\"visible\">True</property>\n"
+                              "    <property name=\"label\">label%u</property>\n",
+                              i, i);
+      if (i > 0)
+        g_string_append_printf (xml,
+                                "    <property name=\"mnemonic_widget\">label%u</property>\n",
+                                i - 1);
+      g_string_append (xml, "  </object>\n");
+    }
+
+  g_string_append (xml, TEST_UTILS_UI_FOOTER);
+
+  path = test_utils_write_project (xml->str);
+  g_string_free (xml, TRUE);
+
+  return path;
+}
+
+static void
+assert_mnemonic_widget (GladeWidget *label, GladeWidget *target)
+{
+  GObject *object = NULL;
+
+  glade_widget_property_get (label, "mnemonic-widget", &object);
+  g_assert_true (object == glade_widget_get_object (target));
+}
+
+static void
+test_widget_by_name (void)
+{
+  GladeProject *project;
+  GladeWidget *label0, *label1;
+  gchar *path;
+
+  g_test_log_set_fatal_handler (test_utils_ignore_gvfs_warning, NULL);
+
+  path = write_synthetic_project (3);
+  g_assert_true ((project = glade_project_load (path)));
+  g_unlink (path);
+  g_free (path);
+
+  g_assert_true ((label0 = glade_project_get_widget_by_name (project, "label0")));
+  g_assert_true ((label1 = glade_project_get_widget_by_name (project, "label1")));
+  g_assert_cmpstr (glade_widget_get_name (label0), ==, "label0");
+  g_assert_null (glade_project_get_widget_by_name (project, "label3"));
+
+  /* Object properties are resolved through the name index at load time */
+  assert_mnemonic_widget (label1, label0);
+
+  /* Renaming moves the index entry */
+  glade_project_set_widget_name (project, label0, "renamed");
+  g_assert_null (glade_project_get_widget_by_name (project, "label0"));
+  g_assert_true (glade_project_get_widget_by_name (project, "renamed") == label0);
+
+  /* The released name can be taken by another widget */
+  glade_project_set_widget_name (project, label1, "label0");
+  g_assert_true (glade_project_get_widget_by_name (project, "label0") == label1);
+  g_assert_null (glade_project_get_widget_by_name (project, "label1"));
+
+  /* Removing drops the entry */
+  glade_project_remove_object (project, glade_widget_get_object (label0));
+  g_assert_null (glade_project_get_widget_by_name (project, "renamed"));
+  g_assert_true (glade_project_get_widget_by_name (project, "label0") == label1);
+
+  g_object_unref (project);
+}
+
+static void
+test_object_stub (void)
+{
+  static const gchar xml[] =
+    "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+    "<!-- Comments before the root element are kept -->\n"
+    "<interface domain=\"stub-test\">\n"
+    "  <requires lib=\"gtk+\" version=\"3.24\"/>\n"
+    "  <object class=\"GtkLabel\" id=\"label0\"/>\n"
+    "  <!-- Comments between objects are skipped -->\n"
+    "  <object class=\"GladeTestUnknown\" id=\"unknown\">\n"
+    "    <property name=\"unknown-property\">value</property>\n"
+    "    <child>\n"
+    "      <object class=\"GtkLabel\" id=\"inner\"/>\n"
+    "    </child>\n"
+    "  </object>\n"
+    "  <object class=\"GtkLabel\" id=\"label1\">\n"
+    "    <property name=\"mnemonic_widget\">label0</property>\n"
+    "  </object>\n"
+    "</interface>\n";
+  GladeProject *project;
+  GladeWidget *label0, *label1, *unknown;
+  GladeXmlNode *node, *child;
+  gchar *type = NULL, *class;
+
+  g_test_log_set_fatal_handler (test_utils_ignore_gvfs_warning, NULL);
+
+  project = test_utils_load_project (xml);
+
+  g_assert_cmpstr (glade_project_get_translation_domain (project), ==, "stub-test");
+  g_assert_true ((label0 = glade_project_get_widget_by_name (project, "label0")));
+  g_assert_true ((label1 = glade_project_get_widget_by_name (project, "label1")));
+  assert_mnemonic_widget (label1, label0);
+
+  /* Unknown classes keep a copy of their xml, children included */
+  g_assert_true ((unknown = glade_project_get_widget_by_name (project, "unknown")));
+  g_assert_null (glade_project_get_widget_by_name (project, "inner"));
+
+  g_object_get (glade_widget_get_object (unknown), "object-type", &type, "xml-node", &node, NULL);
+  g_assert_cmpstr (type, ==, "GladeTestUnknown");
+  g_assert_true (glade_xml_node_verify_silent (node, GLADE_XML_TAG_WIDGET));
+
+  class = glade_xml_get_property_string (node, GLADE_XML_TAG_CLASS);
+  g_assert_cmpstr (class, ==, "GladeTestUnknown");
+  g_free (class);
+
+  g_assert_true ((child = glade_xml_search_child (node, GLADE_XML_TAG_CHILD)));
+  g_assert_nonnull (glade_xml_search_child (child, GLADE_XML_TAG_WIDGET));
+
+  glade_xml_node_delete (node);
+  g_free (type);
+  g_object_unref (project);
+}
+
+static gboolean
+count_ui_message (GladeUIMessageType type, const gchar *message, gpointer user_data)
+{
+  guint *n_errors = user_data;
+
+  if (type == GLADE_UI_ERROR)
+    (*n_errors)++;
+
+  return FALSE;
+}
+
+static void
+test_ui_message_func (void)
+{
+  guint n_errors = 0;
+  gchar *path;
+
+  g_test_log_set_fatal_handler (test_utils_ignore_gvfs_warning, NULL);
+
+  path = test_utils_write_project ("<glade-interface/>\n");
+
+  /* Errors go to the message function instead of a dialog */
+  _glade_util_set_ui_message_func (count_ui_message, &n_errors);
+  g_assert_null (glade_project_load (path));
+  _glade_util_set_ui_message_func (NULL, NULL);
+  g_assert_cmpuint (n_errors, ==, 1);
+
+  g_unlink (path);
+  g_free (path);
+}
+
+static void
+test_late_requires (void)
+{
+  static const gchar xml[] =
+    "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+    "<interface>\n"
+    "  <object class=\"GtkLabel\" id=\"label0\"/>\n"
+    "  <requires lib=\"gtk+\" version=\"3.18\"/>\n"
+    "  <object class=\"GtkLabel\" id=\"label1\"/>\n"
+    "  <requires lib=\"late-catalog\" version=\"1.2\"/>\n"
+    TEST_UTILS_UI_FOOTER;
+  GladeProject *project;
+  GList *libs;
+  guint n_errors = 0;
+  gint major, minor;
+
+  g_test_log_set_fatal_handler (test_utils_ignore_gvfs_warning, NULL);
+
+  /* Requires tags after the objects are read as well */
+  _glade_util_set_ui_message_func (count_ui_message, &n_errors);
+  project = test_utils_load_project (xml);
+  _glade_util_set_ui_message_func (NULL, NULL);
+  g_assert_cmpuint (n_errors, ==, 1);
+
+  glade_project_get_target_version (project, "gtk+", &major, &minor);
+  g_assert_cmpint (major, ==, 3);
+  g_assert_cmpint (minor, ==, 18);
+  glade_project_get_target_version (project, "late-catalog", &major, &minor);
+  g_assert_cmpint (major, ==, 1);
+  g_assert_cmpint (minor, ==, 2);
+
+  /* And the unknown catalog is not lost on save */
+  libs = glade_project_required_libs (project);
+  g_assert_nonnull (g_list_find_custom (libs, "late-catalog", (GCompareFunc) g_strcmp0));
+  g_list_free_full (libs, g_free);
+
+  g_assert_nonnull (glade_project_get_widget_by_name (project, "label1"));
+  g_object_unref (project);
+}
+
+static void
+test_object_references (void)
+{
+  static const gchar xml[] =
+    TEST_UTILS_UI_HEADER
+    "  <object class=\"GtkLabel\" id=\"label0\">\n"
+    "    <property name=\"mnemonic_widget\">label1</property>\n"
+    "  </object>\n"
+    "  <object class=\"GtkLabel\" id=\"label1\">\n"
+    "    <property name=\"mnemonic_widget\">missing</property>\n"
+    "  </object>\n"
+    "  <object class=\"GtkSizeGroup\" id=\"sizegroup\">\n"
+    "    <widgets>\n"
+    "      <widget name=\"label0\"/>\n"
+    "      <widget name=\"label1\"/>\n"
+    "    </widgets>\n"
+    "  </object>\n"
+    TEST_UTILS_UI_FOOTER;
+  GladeProject *project;
+  GladeWidget *label0, *label1, *sizegroup;
+  GObject *object = NULL;
+  GList *widgets = NULL;
+  gchar *path;
+
+  g_test_log_set_fatal_handler (test_utils_ignore_gvfs_warning, NULL);
+
+  path = test_utils_write_project (xml);
+
+  /* Dangling ids are reported once the project is loaded */
+  g_test_expect_message ("GladeUI", G_LOG_LEVEL_MESSAGE,
+                         "Unresolved object references in *label1:mnemonic-widget \"missing\"*");
+  g_assert_true ((project = glade_project_load (path)));
+  g_test_assert_expected_messages ();
+  g_unlink (path);
+  g_free (path);
+
+  g_assert_true ((label0 = glade_project_get_widget_by_name (project, "label0")));
+  g_assert_true ((label1 = glade_project_get_widget_by_name (project, "label1")));
+  g_assert_true ((sizegroup = glade_project_get_widget_by_name (project, "sizegroup")));
+
+  /* References to objects declared later are resolved */
+  assert_mnemonic_widget (label0, label1);
+
+  glade_widget_property_get (label1, "mnemonic-widget", &object);
+  g_assert_null (object);
+
+  /* So are object lists read by the plugins */
+  glade_widget_property_get (sizegroup, "widgets", &widgets);
+  g_assert_cmpuint (g_list_length (widgets), ==, 2);
+  g_assert_true (widgets->data == glade_widget_get_object (label0));
+  g_assert_true (widgets->next->data == glade_widget_get_object (label1));
+
+  g_object_unref (project);
+}
+
+static void
+on_add_widget (GladeProject *project, GladeWidget *widget, gpointer user_data)
+{
+  GladeProperty *property;
+
+  if (g_strcmp0 (glade_widget_get_name (widget), "label0") != 0)
+    return;
+
+  /* What a read hook leaving the ids to the project does */
+  property = glade_widget_get_property (widget, "mnemonic-widget");
+  g_object_set_data_full (G_OBJECT (property), "glade-loaded-object",
+                          g_strdup ("label1"), g_free);
+}
+
+static void
+test_loaded_object_data (void)
+{
+  GladeProject *project;
+  GladeWidget *label0, *label1;
+  gchar *path;
+
+  g_test_log_set_fatal_handler (test_utils_ignore_gvfs_warning, NULL);
+
+  path = test_utils_write_project (TEST_UTILS_UI_HEADER
+                                   "  <object class=\"GtkLabel\" id=\"label0\"/>\n"
+                                   "  <object class=\"GtkLabel\" id=\"label1\"/>\n"
+                                   TEST_UTILS_UI_FOOTER);
+
+  /* Ids left as property data are resolved, whatever the catalog */
+  project = glade_project_new ();
+  g_signal_connect (project, "add-widget", G_CALLBACK (on_add_widget), NULL);
+  g_assert_true (glade_project_load_from_file (project, path));
+
+  g_assert_true ((label0 = glade_project_get_widget_by_name (project, "label0")));
+  g_assert_true ((label1 = glade_project_get_widget_by_name (project, "label1")));
+  assert_mnemonic_widget (label0, label1);
+  g_assert_null (g_object_get_data (G_OBJECT (glade_widget_get_property (label0, "mnemonic-widget")),
+                                    "glade-loaded-object"));
+
+  g_object_unref (project);
+  g_unlink (path);
+  g_free (path);
+}
+
+static gchar *
+write_image (gint size)
+{
+  GdkPixbuf *pixbuf;
+  gchar *path;
+
+  g_assert_true (g_close (g_file_open_tmp ("glade-project-load-XXXXXX.png", &path, NULL), NULL));
+
+  pixbuf = gdk_pixbuf_new (GDK_COLORSPACE_RGB, FALSE, 8, size, size);
+  gdk_pixbuf_fill (pixbuf, 0xff0000ff);
+  g_assert_true (gdk_pixbuf_save (pixbuf, path, "png", NULL, NULL));
+  g_object_unref (pixbuf);
+
+  return path;
+}
+
+static GdkPixbuf *
+get_pixbuf (GladeProject *project, const gchar *name)
+{
+  GladeWidget *image = glade_project_get_widget_by_name (project, name);
+  GdkPixbuf *pixbuf = NULL;
+
+  glade_widget_property_get (image, "pixbuf", &pixbuf);
+  g_assert_nonnull (pixbuf);
+
+  return pixbuf;
+}
+
+static void
+test_pixbuf_cache (void)
+{
+  GladeProject *project;
+  GdkPixbuf *pixbuf0, *pixbuf1;
+  GValue *value;
+  gchar *image_path, *basename, *xml, *path, *fullpath;
+  guint hits, misses, new_hits, new_misses;
+
+  g_test_log_set_fatal_handler (test_utils_ignore_gvfs_warning, NULL);
+
+  image_path = write_image (4);
+  basename = g_path_get_basename (image_path);
+  xml = g_strdup_printf ("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                         "<interface>\n"
+                         "  <requires lib=\"gtk+\" version=\"3.24\"/>\n"
+                         "  <object class=\"GtkImage\" id=\"image0\">\n"
+                         "    <property name=\"pixbuf\">%s</property>\n"
+                         "  </object>\n"
+                         "  <object class=\"GtkImage\" id=\"image1\">\n"
+                         "    <property name=\"pixbuf\">%s</property>\n"
+                         "  </object>\n"
+                         "</interface>\n", basename, basename);
+
+  /* The project must be next to the image */
+  path = test_utils_write_project (xml);
+
+  _glade_util_pixbuf_cache_get_stats (&hits, &misses);
+  g_assert_true ((project = glade_project_load (path)));
+  _glade_util_pixbuf_cache_get_stats (&new_hits, &new_misses);
+
+  /* The image is decoded once and shared */
+  g_assert_cmpuint (new_misses, ==, misses + 1);
+  g_assert_cmpuint (new_hits, ==, hits + 1);
+
+  /* Each reference has its own pixbuf to keep its file name */
+  pixbuf0 = get_pixbuf (project, "image0");
+  pixbuf1 = get_pixbuf (project, "image1");
+  g_assert_true (pixbuf0 != pixbuf1);
+  g_assert_true (gdk_pixbuf_get_pixels (pixbuf0) == gdk_pixbuf_get_pixels (pixbuf1));
+  g_assert_cmpstr (g_object_get_data (G_OBJECT (pixbuf0), "GladeFileName"), ==, basename);
+  g_assert_cmpstr (g_object_get_data (G_OBJECT (pixbuf1), "GladeFileName"), ==, basename);
+
+  /* A modified file is decoded again */
+  fullpath = glade_project_resource_fullpath (project, basename);
+  g_free (image_path);
+  image_path = write_image (8);
+  g_assert_true (g_rename (image_path, fullpath) == 0);
+
+  value = glade_property_def_make_gvalue_from_string
+    (glade_property_get_def (glade_widget_get_property (glade_project_get_widget_by_name (project, "image0"), "pixbuf")),
+     basename, project);
+  _glade_util_pixbuf_cache_get_stats (&hits, &misses);
+  g_assert_cmpuint (misses, ==, new_misses + 1);
+  g_assert_cmpint (gdk_pixbuf_get_width (g_value_get_object (value)), ==, 8);
+  g_value_unset (value);
+  g_free (value);
+
+  g_object_unref (project);
+  g_unlink (fullpath);
+  g_unlink (path);
+  g_free (path);
+  g_free (fullpath);
+  g_free (xml);
+  g_free (basename);
+  g_free (image_path);
+}
+
+static void
+test_load_time (gconstpointer data)
+{
+  guint n_labels = GPOINTER_TO_UINT (data);
+  GladeProject *project;
+  gdouble elapsed;
+  gchar *path;
+
+  g_test_log_set_fatal_handler (test_utils_ignore_gvfs_warning, NULL);
+
+  path = write_synthetic_project (n_labels);
+
+  g_test_timer_start ();
+  g_assert_true ((project = glade_project_load (path)));
+  elapsed = g_test_timer_elapsed ();
+
+  g_test_minimized_result (elapsed, "Loaded %u widgets in %.3f seconds",
+                           n_labels, elapsed);
+
+  g_assert_cmpuint (g_list_length ((GList *) glade_project_get_objects (project)), ==, n_labels);
+
+  g_object_unref (project);
+  g_unlink (path);
+  g_free (path);
+}
+
+static void
+add_load_time_test (guint n_labels)
+{
+  gchar *test_path = g_strdup_printf ("/ProjectLoad/LoadTime/%u", n_labels);
+
+  g_test_add_data_func (test_path, GUINT_TO_POINTER (n_labels), test_load_time);
+  g_free (test_path);
+}
+
+int
+main (int argc, char *argv[])
+{
+  gtk_test_init (&argc, &argv, NULL);
+
+  glade_init ();
+  glade_app_get ();
+
+  g_test_add_func ("/ProjectLoad/WidgetByName", test_widget_by_name);
+  g_test_add_func ("/ProjectLoad/ObjectStub", test_object_stub);
+  g_test_add_func ("/ProjectLoad/ObjectReferences", test_object_references);
+  g_test_add_func ("/ProjectLoad/LoadedObjectData", test_loaded_object_data);
+  g_test_add_func ("/ProjectLoad/UIMessageFunc", test_ui_message_func);
+  g_test_add_func ("/ProjectLoad/LateRequires", test_late_requires);
+  g_test_add_func ("/ProjectLoad/PixbufCache", test_pixbuf_cache);
+
+  /* Benchmarks, run with -m perf */
+  if (g_test_perf ())
+    {
+      add_load_time_test (1000);
+      add_load_time_test (5000);
+      add_load_time_test (20000);
+    }
+
+  return g_test_run ();
+}
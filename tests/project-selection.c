@@ -0,0 +1,110 @@
+#include <glib.h>
+#include <glib-object.h>
+
+#include <gladeui/glade-app.h>
+
+#include "test-utils.h"
+
+static void
+on_selection_changed (GladeProject *project, guint *n_changes)
+{
+  (*n_changes)++;
+}
+
+static GList *
+get_objects (GladeProject *project, const gchar *first_name, ...)
+{
+  GList *objects = NULL;
+  const gchar *name;
+  va_list args;
+
+  va_start (args, first_name);
+
+  for (name = first_name; name; name = va_arg (args, const gchar *))
+    objects = g_list_append (objects,
+                             glade_widget_get_object (glade_project_get_widget_by_name (project, name)));
+
+  va_end (args);
+
+  return objects;
+}
+
+static void
+assert_selected (GladeProject *project, const gchar *name, gboolean selected)
+{
+  GladeWidget *widget = glade_project_get_widget_by_name (project, name);
+
+  g_assert_cmpint (glade_project_is_selected (project, glade_widget_get_object (widget)), ==, selected);
+}
+
+static void
+test_selection_many (void)
+{
+  GladeProject *project;
+  GList *objects, *invalid;
+  guint n_changes = 0;
+  GtkWidget *label;
+
+  g_test_log_set_fatal_handler (test_utils_ignore_gvfs_warning, NULL);
+
+  project = test_utils_load_box (3, 0);
+  g_signal_connect (project, "selection-changed", G_CALLBACK (on_selection_changed), &n_changes);
+
+  /* A batch is notified once */
+  objects = get_objects (project, "label0", "label1", NULL);
+  glade_project_selection_add_many (project, objects, TRUE);
+  g_assert_cmpuint (n_changes, ==, 1);
+  assert_selected (project, "label0", TRUE);
+  assert_selected (project, "label1", TRUE);
+  assert_selected (project, "label2", FALSE);
+  g_assert_cmpuint (g_list_length (glade_project_selection_get (project)), ==, 2);
+
+  /* And not at all if nothing changed */
+  glade_project_selection_add_many (project, objects, TRUE);
+  g_assert_cmpuint (n_changes, ==, 1);
+
+  /* A list with an object out of the project is not applied at all */
+  label = g_object_ref_sink (gtk_label_new (NULL));
+  invalid = get_objects (project, "label2", NULL);
+  invalid = g_list_append (invalid, label);
+
+  g_test_expect_message ("GladeUI", G_LOG_LEVEL_CRITICAL, "*glade_project_has_object*");
+  glade_project_selection_add_many (project, invalid, TRUE);
+  g_test_assert_expected_messages ();
+  g_assert_cmpuint (n_changes, ==, 1);
+  assert_selected (project, "label2", FALSE);
+
+  /* Objects which are not selected are ignored when removing */
+  glade_project_selection_remove_many (project, invalid, TRUE);
+  g_assert_cmpuint (n_changes, ==, 1);
+
+  glade_project_selection_remove_many (project, objects, TRUE);
+  g_assert_cmpuint (n_changes, ==, 2);
+  assert_selected (project, "label0", FALSE);
+  assert_selected (project, "label1", FALSE);
+  g_assert_null (glade_project_selection_get (project));
+
+  /* Without emitting the signal when asked to */
+  glade_project_selection_add_many (project, objects, FALSE);
+  g_assert_cmpuint (n_changes, ==, 2);
+  assert_selected (project, "label0", TRUE);
+
+  g_list_free (invalid);
+  g_list_free (objects);
+  gtk_widget_destroy (label);
+  g_object_unref (label);
+  g_object_unref (project);
+}
+
+int
+main (int argc, char *argv[])
+{
+  gtk_test_init (&argc, &argv, NULL);
+
+  glade_init ();
+  glade_app_get ();
+
+  g_test_add_func ("/ProjectSelection/Many", test_selection_many);
+
+  return g_test_run ();
+}
@@ -0,0 +1,154 @@
+#include <glib.h>
+#include <glib-object.h>
+
+#include <gladeui/glade-app.h>
+
+#include "test-utils.h"
+
+#define N_EDITS 300
+
+static GladeProject *
+load_project (void)
+{
+  return test_utils_load_project (TEST_UTILS_UI_HEADER
+                                  "  <object class=\"GtkLabel\" id=\"label0\"/>\n"
+                                  "  <object class=\"GtkLabel\" id=\"label1\"/>\n"
+                                  TEST_UTILS_UI_FOOTER);
+}
+
+static void
+set_label (GladeProject *project, const gchar *name, guint serial)
+{
+  GladeWidget *widget = glade_project_get_widget_by_name (project, name);
+  gchar *value = g_strdup_printf ("text%u", serial);
+
+  glade_command_set_property (glade_widget_get_property (widget, "label"), value);
+  g_free (value);
+}
+
+static guint
+undo_all (GladeProject *project)
+{
+  guint n_undone = 0;
+
+  while (glade_project_next_undo_item (project))
+    {
+      glade_project_undo (project);
+      n_undone++;
+    }
+
+  return n_undone;
+}
+
+static void
+test_undo_limits (void)
+{
+  GladeProject *project;
+  gsize size, limited_size;
+  guint i, n_commands;
+
+  g_test_log_set_fatal_handler (test_utils_ignore_gvfs_warning, NULL);
+
+  project = load_project ();
+
+  /* Alternate between two labels so that no command unifies */
+  for (i = 0; i < N_EDITS; i++)
+    set_label (project, i % 2 ? "label1" : "label0", i);
+
+  size = glade_project_get_undo_size (project, &n_commands);
+  g_assert_cmpuint (n_commands, ==, N_EDITS);
+  g_assert_cmpuint (size, >, 0);
+
+  /* Lowering the limits trims the existing history */
+  glade_project_set_undo_limits (project, 50, 0);
+  limited_size = glade_project_get_undo_size (project, &n_commands);
+  g_assert_cmpuint (n_commands, ==, 50);
+  g_assert_cmpuint (limited_size, <, size);
+
+  for (i = 0; i < N_EDITS; i++)
+    {
+      set_label (project, i % 2 ? "label1" : "label0", i);
+      glade_project_get_undo_size (project, &n_commands);
+      g_assert_cmpuint (n_commands, <=, 50);
+    }
+
+  /* The memory cap alone also bounds the history */
+  glade_project_set_undo_limits (project, 0, limited_size / 5);
+  size = glade_project_get_undo_size (project, &n_commands);
+  g_assert_cmpuint (size, <=, limited_size / 5);
+  g_assert_cmpuint (n_commands, >=, 1);
+
+  /* What is left can still be undone, down to the oldest kept command */
+  g_assert_cmpuint (undo_all (project), ==, n_commands);
+  g_assert_true (glade_project_next_redo_item (project) != NULL);
+
+  /* And a new command drops every command that could be redone */
+  set_label (project, "label0", N_EDITS);
+  glade_project_get_undo_size (project, &n_commands);
+  g_assert_cmpuint (n_commands, ==, 1);
+  g_assert_null (glade_project_next_redo_item (project));
+
+  g_object_unref (project);
+}
+
+static gchar *
+get_label (GladeProject *project, const gchar *name)
+{
+  GladeWidget *widget = glade_project_get_widget_by_name (project, name);
+  gchar *value = NULL;
+
+  glade_widget_property_get (widget, "label", &value);
+
+  return g_strdup (value);
+}
+
+static void
+test_undo_compaction (void)
+{
+  GladeProject *project;
+  gchar *original, *restored;
+  guint i, n_commands;
+
+  g_test_log_set_fatal_handler (test_utils_ignore_gvfs_warning, NULL);
+
+  project = load_project ();
+  glade_project_set_undo_compaction (project, TRUE);
+  original = get_label (project, "label0");
+
+  /* Marking the project as saved keeps consecutive edits of the same
+   * property from unifying when they are pushed.
+   */
+  for (i = 0; i < N_EDITS; i++)
+    {
+      set_label (project, "label0", i);
+      glade_project_set_modified (project, FALSE);
+    }
+
+  /* Only the recent edits are kept separately */
+  glade_project_get_undo_size (project, &n_commands);
+  g_assert_cmpuint (n_commands, <, N_EDITS);
+  g_assert_cmpuint (n_commands, >, 1);
+
+  /* Undoing everything still restores the original value */
+  g_assert_cmpuint (undo_all (project), ==, n_commands);
+  restored = get_label (project, "label0");
+  g_assert_cmpstr (restored, ==, original);
+
+  g_free (restored);
+  g_free (original);
+  g_object_unref (project);
+}
+
+int
+main (int argc, char *argv[])
+{
+  gtk_test_init (&argc, &argv, NULL);
+
+  glade_init ();
+  glade_app_get ();
+
+  g_test_add_func ("/ProjectUndo/Limits", test_undo_limits);
+  g_test_add_func ("/ProjectUndo/Compaction", test_undo_compaction);
+
+  return g_test_run ();
+}
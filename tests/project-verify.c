@@ -0,0 +1,179 @@
+#include <string.h>
+
+#include <glib.h>
+#include <glib-object.h>
+
+#include <gladeui/glade-app.h>
+#include <gladeui/glade-private.h>
+
+#include "test-utils.h"
+
+#define VERIFY_FLAGS (GLADE_VERIFY_VERSIONS | GLADE_VERIFY_DEPRECATIONS | GLADE_VERIFY_UNRECOGNIZED)
+
+static gboolean
+is_verified (GladeProject *project, const gchar *name)
+{
+  return _glade_project_widget_is_verified (project,
+                                            glade_project_get_widget_by_name (project, name));
+}
+
+static GladeProperty *
+get_property (GladeProject *project, const gchar *name, const gchar *id)
+{
+  return glade_widget_get_property (glade_project_get_widget_by_name (project, name), id);
+}
+
+static void
+test_verify_cache (void)
+{
+  static const gchar xml[] =
+    "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+    "<interface>\n"
+    "  <requires lib=\"gtk+\" version=\"3.0\"/>\n"
+    "  <object class=\"GtkBox\" id=\"box\">\n"
+    "    <child>\n"
+    "      <object class=\"GtkLabel\" id=\"label0\">\n"
+    "        <property name=\"lines\">2</property>\n"
+    "      </object>\n"
+    "    </child>\n"
+    "    <child>\n"
+    "      <object class=\"GtkLabel\" id=\"label1\"/>\n"
+    "    </child>\n"
+    "  </object>\n"
+    "</interface>\n";
+  GladeProject *project;
+
+  g_test_log_set_fatal_handler (test_utils_ignore_gvfs_warning, NULL);
+
+  project = test_utils_load_project (xml);
+
+  /* GtkLabel:lines is only available since 3.10 */
+  g_assert_false (is_verified (project, "label0"));
+  g_assert_false (glade_project_verify (project, FALSE, VERIFY_FLAGS));
+  g_assert_true (is_verified (project, "box"));
+  g_assert_true (is_verified (project, "label0"));
+  g_assert_true (is_verified (project, "label1"));
+
+  /* Only the changed widget is verified again */
+  glade_command_set_property (get_property (project, "label1", "label"), "text");
+  g_assert_true (is_verified (project, "box"));
+  g_assert_true (is_verified (project, "label0"));
+  g_assert_false (is_verified (project, "label1"));
+  g_assert_false (glade_project_verify (project, FALSE, VERIFY_FLAGS));
+  g_assert_true (is_verified (project, "label1"));
+
+  /* Targeting another version verifies everything again */
+  glade_project_set_target_version (project, "gtk+", 3, 24);
+  g_assert_false (is_verified (project, "box"));
+  g_assert_true (glade_project_verify (project, FALSE, VERIFY_FLAGS));
+  g_assert_true (is_verified (project, "box"));
+
+  glade_project_set_target_version (project, "gtk+", 3, 24);
+  g_assert_true (is_verified (project, "box"));
+
+  glade_project_set_target_version (project, "gtk+", 3, 0);
+  g_assert_false (glade_project_verify (project, FALSE, VERIFY_FLAGS));
+
+  /* Unset properties are not reported */
+  glade_command_set_property (get_property (project, "label0", "lines"), -1);
+  g_assert_false (is_verified (project, "label0"));
+  g_assert_true (glade_project_verify (project, FALSE, VERIFY_FLAGS));
+
+  g_object_unref (project);
+}
+
+static void
+test_verify_message (void)
+{
+  static const gchar xml[] =
+    "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+    "<interface>\n"
+    "  <requires lib=\"gtk+\" version=\"3.0\"/>\n"
+    "  <object class=\"GtkLabel\" id=\"label0\">\n"
+    "    <property name=\"lines\">2</property>\n"
+    "  </object>\n"
+    "</interface>\n";
+  GladeProject *project;
+  gchar *message;
+
+  g_test_log_set_fatal_handler (test_utils_ignore_gvfs_warning, NULL);
+
+  project = test_utils_load_project (xml);
+
+  message = _glade_project_verify_message (project, VERIFY_FLAGS);
+  g_assert_nonnull (message);
+  g_assert_nonnull (strstr (message, "[label0]"));
+  g_assert_nonnull (strstr (message, "lines"));
+  g_free (message);
+
+  glade_project_set_target_version (project, "gtk+", 3, 24);
+  g_assert_null (_glade_project_verify_message (project, VERIFY_FLAGS));
+
+  g_object_unref (project);
+}
+
+/* Verifies a project with @data labels after changing only one of them */
+static void
+test_verify_time (gconstpointer data)
+{
+  guint n_labels = GPOINTER_TO_UINT (data);
+  gdouble cold_elapsed, warm_elapsed;
+  GladeProject *project;
+  GString *xml;
+  guint i;
+
+  g_test_log_set_fatal_handler (test_utils_ignore_gvfs_warning, NULL);
+
+  xml = g_string_new ("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                      "<interface>\n"
+                      "  <requires lib=\"gtk+\" version=\"3.24\"/>\n"
+                      "  <object class=\"GtkBox\" id=\"box\">\n");
+
+  for (i = 0; i < n_labels; i++)
+    g_string_append_printf (xml,
+                            "    <child>\n"
+                            "      <object class=\"GtkLabel\" id=\"label%u\">\n"
+                            "        <property name=\"label\">label%u</property>\n"
+                            "        <property name=\"visible\">True</property>\n"
+                            "      </object>\n"
+                            "    </child>\n",
+                            i, i);
+
+  g_string_append (xml, "  </object>\n</interface>\n");
+  project = test_utils_load_project (xml->str);
+  g_string_free (xml, TRUE);
+
+  g_test_timer_start ();
+  g_assert_true (glade_project_verify (project, FALSE, VERIFY_FLAGS));
+  cold_elapsed = g_test_timer_elapsed ();
+
+  glade_command_set_property (get_property (project, "label0", "label"), "text");
+
+  g_test_timer_start ();
+  g_assert_true (glade_project_verify (project, FALSE, VERIFY_FLAGS));
+  warm_elapsed = g_test_timer_elapsed ();
+
+  g_test_message ("Verified %u labels in %.3f seconds", n_labels, cold_elapsed);
+  g_test_minimized_result (warm_elapsed, "Verified %u labels again in %.3f seconds",
+                           n_labels, warm_elapsed);
+
+  g_object_unref (project);
+}
+
+int
+main (int argc, char *argv[])
+{
+  gtk_test_init (&argc, &argv, NULL);
+
+  glade_init ();
+  glade_app_get ();
+
+  g_test_add_func ("/ProjectVerify/Cache", test_verify_cache);
+  g_test_add_func ("/ProjectVerify/Message", test_verify_message);
+
+  /* Benchmarks, run with -m perf */
+  if (g_test_perf ())
+    g_test_add_data_func ("/ProjectVerify/Time/5000", GUINT_TO_POINTER (5000), test_verify_time);
+
+  return g_test_run ();
+}
@@ -0,0 +1,493 @@
+#include <string.h>
+
+#include <glib.h>
+#include <glib/gstdio.h>
+#include <glib-object.h>
+
+#include <gladeui/glade-app.h>
+#include <gladeui/glade-private.h>
+
+#include "test-utils.h"
+
+#define N_GROUPS 8
+#define N_EDITS  200
+
+/* Writes a project with N_GROUPS windows, each one holding a box with
+ * a label, a button and a spin button using its own toplevel adjustment.
+ */
+static gchar *
+write_project (void)
+{
+  GString *xml = g_string_new (TEST_UTILS_UI_HEADER);
+  gchar *path;
+  guint i;
+
+  for (i = 0; i < N_GROUPS; i++)
+    g_string_append_printf (xml,
+                            "  <object class=\"GtkAdjustment\" id=\"adjustment%u\">\n"
+                            "    <property name=\"upper\">100</property>\n"
+                            "    <property name=\"step_increment\">1</property>\n"
+                            "  </object>\n"
+                            "  <object class=\"GtkWindow\" id=\"window%u\">\n"
+                            "    <child>\n"
+                            "      <object class=\"GtkBox\" id=\"box%u\">\n"
+                            "        <property name=\"visible\">True</property>\n"
+                            "        <property name=\"orientation\">vertical</property>\n"
+                            "        <child>\n"
+                            "          <object class=\"GtkLabel\" id=\"label%u\">\n"
+                            "            <property name=\"visible\">True</property>\n"
+                            "            <property name=\"label\">label%u</property>\n"
+                            "          </object>\n"
+                            "        </child>\n"
+                            "        <child>\n"
+                            "          <object class=\"GtkButton\" id=\"button%u\">\n"
+                            "            <property name=\"label\">button%u</property>\n"
+                            "            <property name=\"visible\">True</property>\n"
+                            "          </object>\n"
+                            "        </child>\n"
+                            "        <child>\n"
+                            "          <object class=\"GtkSpinButton\" id=\"spinbutton%u\">\n"
+                            "            <property name=\"visible\">True</property>\n"
+                            "            <property name=\"adjustment\">adjustment%u</property>\n"
+                            "          </object>\n"
+                            "        </child>\n"
+                            "      </object>\n"
+                            "    </child>\n"
+                            "  </object>\n",
+                            i, i, i, i, i, i, i, i, i);
+
+  g_string_append (xml, TEST_UTILS_UI_FOOTER);
+
+  path = test_utils_write_project (xml->str);
+  g_string_free (xml, TRUE);
+
+  return path;
+}
+
+static GladeWidget *
+random_widget (GladeProject *project, GRand *rand, const gchar *prefix)
+{
+  GladeWidget *widget;
+  gchar *name;
+
+  /* Widgets may have been renamed, in that case leave them alone */
+  name = g_strdup_printf ("%s%d", prefix, g_rand_int_range (rand, 0, N_GROUPS));
+  widget = glade_project_get_widget_by_name (project, name);
+  g_free (name);
+
+  return widget;
+}
+
+static void
+random_edit (GladeProject *project, GRand *rand, guint serial)
+{
+  GladeWidget *widget;
+  GladeSignal *signal;
+  gchar *value;
+
+  switch (g_rand_int_range (rand, 0, 7))
+    {
+      case 0:
+        if ((widget = random_widget (project, rand, "label")))
+          {
+            value = g_strdup_printf ("text%u", serial);
+            glade_command_set_property (glade_widget_get_property (widget, "label"), value);
+            g_free (value);
+          }
+        break;
+      case 1:
+        /* Renaming an adjustment must also rewrite the spin button using it */
+        if ((widget = random_widget (project, rand,
+                                     g_rand_boolean (rand) ? "box" : "adjustment")))
+          {
+            value = g_strdup_printf ("renamed%u", serial);
+            glade_command_set_name (widget, value);
+            g_free (value);
+          }
+        break;
+      case 2:
+        if ((widget = random_widget (project, rand, "label")))
+          glade_command_set_i18n (glade_widget_get_property (widget, "label"),
+                                  g_rand_boolean (rand), "context", NULL);
+        break;
+      case 3:
+        if ((widget = random_widget (project, rand, "button")))
+          {
+            value = g_strdup_printf ("on_clicked%u", serial);
+            signal = glade_signal_new (glade_widget_adaptor_get_signal_def (glade_widget_get_adaptor (widget),
+                                                                            "clicked"),
+                                       value, NULL, FALSE, FALSE);
+            glade_command_add_signal (widget, signal);
+            g_object_unref (signal);
+            g_free (value);
+          }
+        break;
+      case 4:
+        {
+          GladeWidget *adjustment = random_widget (project, rand, "adjustment");
+
+          if ((widget = random_widget (project, rand, "spinbutton")) && adjustment)
+            glade_command_set_property (glade_widget_get_property (widget, "adjustment"),
+                                        glade_widget_get_object (adjustment));
+          break;
+        }
+      case 5:
+        glade_project_undo (project);
+        break;
+      case 6:
+        glade_project_redo (project);
+        break;
+    }
+}
+
+static gchar *
+save_contents (GladeProject *project, const gchar *path)
+{
+  gchar *contents = NULL;
+
+  g_assert_true (glade_project_save (project, path, NULL));
+  g_assert_true (g_file_get_contents (path, &contents, NULL, NULL));
+
+  return contents;
+}
+
+static void
+test_write_cache (void)
+{
+  GladeProject *project;
+  gchar *path, *cached, *fresh;
+  GRand *rand;
+  guint i;
+
+  g_test_log_set_fatal_handler (test_utils_ignore_gvfs_warning, NULL);
+
+  path = write_project ();
+  g_assert_true ((project = glade_project_load (path)));
+  rand = g_rand_new_with_seed (g_test_rand_int ());
+
+  for (i = 0; i < N_EDITS; i++)
+    {
+      random_edit (project, rand, i);
+
+      /* Write once using the cached toplevels, then again from scratch */
+      cached = save_contents (project, path);
+      _glade_project_write_cache_invalidate (project, NULL);
+      fresh = save_contents (project, path);
+
+      g_assert_cmpstr (cached, ==, fresh);
+
+      g_free (cached);
+      g_free (fresh);
+    }
+
+  g_rand_free (rand);
+  g_object_unref (project);
+  g_unlink (path);
+  g_free (path);
+}
+
+static void
+on_autosaved (GladeProject *project, const GError *error, guint *n_autosaves)
+{
+  g_assert_no_error (error);
+  (*n_autosaves)++;
+}
+
+static void
+test_autosave (void)
+{
+  GladeProject *project;
+  gchar *path, *dirname, *basename, *autoname, *autosave_path, *autosaved, *saved;
+  guint n_autosaves = 0;
+
+  g_test_log_set_fatal_handler (test_utils_ignore_gvfs_warning, NULL);
+
+  path = write_project ();
+  g_assert_true ((project = glade_project_load (path)));
+  g_signal_connect (project, "autosaved", G_CALLBACK (on_autosaved), &n_autosaves);
+
+  dirname = g_path_get_dirname (glade_project_get_path (project));
+  basename = g_path_get_basename (glade_project_get_path (project));
+  autoname = g_strdup_printf ("#%s#", basename);
+  autosave_path = g_build_filename (dirname, autoname, NULL);
+
+  /* Requests made while a write is in flight coalesce into a single one */
+  glade_project_queue_autosave (project);
+  glade_project_queue_autosave (project);
+  glade_project_queue_autosave (project);
+
+  while (n_autosaves < 2)
+    g_main_context_iteration (NULL, TRUE);
+
+  g_assert_cmpuint (n_autosaves, ==, 2);
+  g_assert_true (g_file_get_contents (autosave_path, &autosaved, NULL, NULL));
+
+  /* The autosave is identical to a regular save, which removes it */
+  saved = save_contents (project, path);
+  g_assert_cmpstr (autosaved, ==, saved);
+  g_assert_false (g_file_test (autosave_path, G_FILE_TEST_EXISTS));
+
+  g_object_unref (project);
+  g_unlink (path);
+  g_free (autosaved);
+  g_free (saved);
+  g_free (autosave_path);
+  g_free (autoname);
+  g_free (basename);
+  g_free (dirname);
+  g_free (path);
+}
+
+static gboolean
+on_timeout (gpointer user_data)
+{
+  *((gboolean *) user_data) = TRUE;
+  return G_SOURCE_REMOVE;
+}
+
+static void
+test_autosave_close (void)
+{
+  GladeProject *project;
+  gchar *path, *dirname, *basename, *autoname, *autosave_path;
+  gboolean timeout = FALSE;
+  guint n_autosaves = 0;
+
+  g_test_log_set_fatal_handler (test_utils_ignore_gvfs_warning, NULL);
+
+  path = write_project ();
+  g_assert_true ((project = glade_project_load (path)));
+  g_signal_connect (project, "autosaved", G_CALLBACK (on_autosaved), &n_autosaves);
+  g_object_add_weak_pointer (G_OBJECT (project), (gpointer *) &project);
+
+  dirname = g_path_get_dirname (glade_project_get_path (project));
+  basename = g_path_get_basename (glade_project_get_path (project));
+  autoname = g_strdup_printf ("#%s#", basename);
+  autosave_path = g_build_filename (dirname, autoname, NULL);
+
+  /* A queued autosave does not keep the project alive */
+  glade_project_queue_autosave (project);
+  glade_project_queue_autosave (project);
+  g_object_unref (project);
+  g_assert_null (project);
+
+  /* And completes without telling anyone nor writing again */
+  g_timeout_add (200, on_timeout, &timeout);
+  while (!timeout)
+    g_main_context_iteration (NULL, TRUE);
+
+  g_assert_cmpuint (n_autosaves, ==, 0);
+
+  g_unlink (autosave_path);
+  g_unlink (path);
+  g_free (autosave_path);
+  g_free (autoname);
+  g_free (basename);
+  g_free (dirname);
+  g_free (path);
+}
+
+static void
+set_label (GladeProject *project, const gchar *name, const gchar *label)
+{
+  GladeWidget *widget = glade_project_get_widget_by_name (project, name);
+
+  glade_command_set_property (glade_widget_get_property (widget, "label"), label);
+}
+
+static guint
+count_changed_chunks (GPtrArray *old_chunks, GPtrArray *new_chunks)
+{
+  guint i, n_changed = 0;
+
+  g_assert_cmpuint (old_chunks->len, ==, new_chunks->len);
+
+  for (i = 0; i < old_chunks->len; i++)
+    if (g_strcmp0 (g_ptr_array_index (old_chunks, i), g_ptr_array_index (new_chunks, i)) != 0)
+      n_changed++;
+
+  return n_changed;
+}
+
+static void
+test_preview_chunks (void)
+{
+  GPtrArray *chunks, *new_chunks;
+  GladeProject *project;
+  GladeWidget *window;
+  GtkBuilder *builder;
+  GString *ui;
+  gchar *path;
+  guint i;
+
+  g_test_log_set_fatal_handler (test_utils_ignore_gvfs_warning, NULL);
+
+  path = write_project ();
+  g_assert_true ((project = glade_project_load (path)));
+  window = glade_project_get_widget_by_name (project, "window0");
+
+  /* The document head and tail, the window and the adjustment it uses */
+  chunks = _glade_project_write_preview (project, window);
+  g_assert_cmpuint (chunks->len, ==, 4);
+
+  ui = g_string_new (NULL);
+  for (i = 0; i < chunks->len; i++)
+    g_string_append (ui, g_ptr_array_index (chunks, i));
+
+  builder = gtk_builder_new ();
+  g_assert_true (gtk_builder_add_from_string (builder, ui->str, ui->len, NULL));
+  g_assert_nonnull (gtk_builder_get_object (builder, "adjustment0"));
+  g_assert_nonnull (gtk_builder_get_object (builder, "window0"));
+  g_assert_null (gtk_builder_get_object (builder, "window1"));
+  gtk_widget_destroy (GTK_WIDGET (gtk_builder_get_object (builder, "window0")));
+  g_object_unref (builder);
+  g_string_free (ui, TRUE);
+
+  /* Other toplevels do not affect the preview */
+  set_label (project, "label1", "changed");
+  new_chunks = _glade_project_write_preview (project, window);
+  g_assert_cmpuint (count_changed_chunks (chunks, new_chunks), ==, 0);
+  g_ptr_array_unref (new_chunks);
+
+  /* And only the chunk of the changed toplevel differs */
+  set_label (project, "label0", "changed");
+  new_chunks = _glade_project_write_preview (project, window);
+  g_assert_cmpuint (count_changed_chunks (chunks, new_chunks), ==, 1);
+  g_ptr_array_unref (new_chunks);
+
+  g_ptr_array_unref (chunks);
+  g_object_unref (project);
+  g_unlink (path);
+  g_free (path);
+}
+
+static gboolean
+chunks_contain (GPtrArray *chunks, const gchar *text)
+{
+  guint i;
+
+  for (i = 0; i < chunks->len; i++)
+    if (strstr (g_ptr_array_index (chunks, i), text))
+      return TRUE;
+
+  return FALSE;
+}
+
+static void
+test_preview_size_group (void)
+{
+  static const gchar xml[] =
+    TEST_UTILS_UI_HEADER
+    "  <object class=\"GtkWindow\" id=\"window\">\n"
+    "    <child>\n"
+    "      <object class=\"GtkBox\" id=\"box\">\n"
+    "        <child>\n"
+    "          <object class=\"GtkLabel\" id=\"label0\"/>\n"
+    "        </child>\n"
+    "        <child>\n"
+    "          <object class=\"GtkLabel\" id=\"label1\"/>\n"
+    "        </child>\n"
+    "      </object>\n"
+    "    </child>\n"
+    "  </object>\n"
+    "  <object class=\"GtkSizeGroup\" id=\"sizegroup\">\n"
+    "    <widgets>\n"
+    "      <widget name=\"label0\"/>\n"
+    "      <widget name=\"label1\"/>\n"
+    "    </widgets>\n"
+    "  </object>\n"
+    "  <object class=\"GtkWindow\" id=\"other\"/>\n"
+    TEST_UTILS_UI_FOOTER;
+  GladeProject *project;
+  GPtrArray *chunks;
+
+  g_test_log_set_fatal_handler (test_utils_ignore_gvfs_warning, NULL);
+
+  project = test_utils_load_project (xml);
+
+  /* The size group is not used by the window, but it uses its children */
+  chunks = _glade_project_write_preview (project, glade_project_get_widget_by_name (project, "window"));
+  g_assert_cmpuint (chunks->len, ==, 4);
+  g_assert_true (chunks_contain (chunks, "id=\"sizegroup\""));
+  g_assert_false (chunks_contain (chunks, "id=\"other\""));
+
+  g_ptr_array_unref (chunks);
+  g_object_unref (project);
+}
+
+static void
+test_preview_framing (void)
+{
+  static const gchar xml[] =
+    "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+    "<!--toplevels-->\n"
+    "<interface>\n"
+    "  <requires lib=\"gtk+\" version=\"3.24\"/>\n"
+    "  <object class=\"GtkAdjustment\" id=\"adjustment\"/>\n"
+    "  <object class=\"GtkWindow\" id=\"window\">\n"
+    "    <child>\n"
+    "      <object class=\"GtkSpinButton\" id=\"spinbutton\">\n"
+    "        <property name=\"adjustment\">adjustment</property>\n"
+    "      </object>\n"
+    "    </child>\n"
+    "  </object>\n"
+    TEST_UTILS_UI_FOOTER;
+  GladeProject *project;
+  GtkBuilder *builder;
+  GPtrArray *chunks;
+  const gchar *chunk;
+  GString *ui;
+  guint i;
+
+  g_test_log_set_fatal_handler (test_utils_ignore_gvfs_warning, NULL);
+
+  project = test_utils_load_project (xml);
+
+  /* A comment in the document head looking like the split mark is kept */
+  chunks = _glade_project_write_preview (project, glade_project_get_widget_by_name (project, "window"));
+  g_assert_cmpuint (chunks->len, ==, 4);
+
+  chunk = g_ptr_array_index (chunks, 0);
+  g_assert_nonnull (strstr (chunk, "<!--toplevels-->"));
+  g_assert_nonnull (strstr (chunk, "<interface"));
+  g_assert_null (strstr (chunk, "<object"));
+
+  for (i = 1; i + 1 < chunks->len; i++)
+    g_assert_true (g_str_has_prefix (g_ptr_array_index (chunks, i), "<object"));
+
+  chunk = g_ptr_array_index (chunks, chunks->len - 1);
+  g_assert_nonnull (strstr (chunk, "</interface>"));
+  g_assert_null (strstr (chunk, "<object"));
+
+  ui = g_string_new (NULL);
+  for (i = 0; i < chunks->len; i++)
+    g_string_append (ui, g_ptr_array_index (chunks, i));
+
+  builder = gtk_builder_new ();
+  g_assert_true (gtk_builder_add_from_string (builder, ui->str, ui->len, NULL));
+  g_assert_nonnull (gtk_builder_get_object (builder, "adjustment"));
+  gtk_widget_destroy (GTK_WIDGET (gtk_builder_get_object (builder, "window")));
+  g_object_unref (builder);
+  g_string_free (ui, TRUE);
+
+  g_ptr_array_unref (chunks);
+  g_object_unref (project);
+}
+
+int
+main (int argc, char *argv[])
+{
+  gtk_test_init (&argc, &argv, NULL);
+
+  glade_init ();
+  glade_app_get ();
+
+  g_test_add_func ("/ProjectWrite/Cache", test_write_cache);
+  g_test_add_func ("/ProjectWrite/Autosave", test_autosave);
+  g_test_add_func ("/ProjectWrite/AutosaveClose", test_autosave_close);
+  g_test_add_func ("/ProjectWrite/Preview", test_preview_chunks);
+  g_test_add_func ("/ProjectWrite/PreviewSizeGroup", test_preview_size_group);
+  g_test_add_func ("/ProjectWrite/PreviewFraming", test_preview_framing);
+
+  return g_test_run ();
+}
@@ -0,0 +1,75 @@
+#include <glib.h>
+#include <glib/gstdio.h>
+
+#include "test-utils.h"
+
+/* Avoid warnings from GVFS-RemoteVolumeMonitor */
+gboolean
+test_utils_ignore_gvfs_warning (const gchar *log_domain,
+                                GLogLevelFlags log_level,
+                                const gchar *message,
+                                gpointer user_data)
+{
+  if (g_strcmp0 (log_domain, "GVFS-RemoteVolumeMonitor") == 0)
+    return FALSE;
+
+  return TRUE;
+}
+
+/* Writes @contents to a temporary project file and returns its path */
+gchar *
+test_utils_write_project (const gchar *contents)
+{
+  gchar *path;
+
+  g_assert_true (g_close (g_file_open_tmp ("glade-test-XXXXXX.glade", &path, NULL), NULL));
+  g_assert_true (g_file_set_contents (path, contents, -1, NULL));
+
+  return path;
+}
+
+/* Loads a project from @contents, the file it is read from is removed */
+GladeProject *
+test_utils_load_project (const gchar *contents)
+{
+  GladeProject *project;
+  gchar *path;
+
+  path = test_utils_write_project (contents);
+  g_assert_true ((project = glade_project_load (path)));
+  g_unlink (path);
+  g_free (path);
+
+  return project;
+}
+
+/* Loads a box with @n_labels labels and @n_buttons buttons */
+GladeProject *
+test_utils_load_box (guint n_labels, guint n_buttons)
+{
+  GladeProject *project;
+  GString *xml;
+  guint i;
+
+  xml = g_string_new (TEST_UTILS_UI_HEADER
+                      "  <object class=\"GtkBox\" id=\"box\">\n");
+
+  for (i = 0; i < n_labels; i++)
+    g_string_append_printf (xml,
+                            "    <child>\n"
+                            "      <object class=\"GtkLabel\" id=\"label%u\"/>\n"
+                            "    </child>\n", i);
+
+  for (i = 0; i < n_buttons; i++)
+    g_string_append_printf (xml,
+                            "    <child>\n"
+                            "      <object class=\"GtkButton\" id=\"button%u\"/>\n"
+                            "    </child>\n", i);
+
+  g_string_append (xml, "  </object>\n" TEST_UTILS_UI_FOOTER);
+
+  project = test_utils_load_project (xml->str);
+  g_string_free (xml, TRUE);
+
+  return project;
+}
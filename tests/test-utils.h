@@ -0,0 +1,29 @@
+#ifndef __TEST_UTILS_H__
+#define __TEST_UTILS_H__
+
+#include <gladeui/glade-app.h>
+
+G_BEGIN_DECLS
+
+#define TEST_UTILS_UI_HEADER                            \
+  "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"        \
+  "<interface>\n"                                       \
+  "  <requires lib=\"gtk+\" version=\"3.24\"/>\n"
+
+#define TEST_UTILS_UI_FOOTER "</interface>\n"
+
+gboolean      test_utils_ignore_gvfs_warning (const gchar    *log_domain,
+                                              GLogLevelFlags  log_level,
+                                              const gchar    *message,
+                                              gpointer        user_data);
+
+gchar        *test_utils_write_project       (const gchar    *contents);
+
+GladeProject *test_utils_load_project        (const gchar    *contents);
+
+GladeProject *test_utils_load_box            (guint           n_labels,
+                                              guint           n_buttons);
+
+G_END_DECLS
+
+#endif /* __TEST_UTILS_H__ */
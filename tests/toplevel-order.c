@@ -59,6 +59,265 @@ add_tsort_test_real (const gchar *path, gchar *nodes[], gchar *edges[][2])
 
 #define add_tsort_test(nodes, edges) add_tsort_test_real ("/Tsort/"#nodes, nodes, edges)
 
+/* Straight list based Kahn's algorithm, used as reference to check that
+ * _glade_tsort() output order and remaining edges do not change.
+ */
+static gboolean
+reference_tsort_has_no_incoming_edge (gpointer node, GList *edges)
+{
+  GList *l;
+
+  for (l = edges; l; l = g_list_next (l))
+    {
+      _NodeEdge *edge = l->data;
+
+      if (node == edge->successor)
+        return FALSE;
+    }
+
+  return TRUE;
+}
+
+static GList *
+reference_tsort (GList **nodes, GList **edges)
+{
+  GList *l, *next, *sorted_nodes = NULL;
+
+  for (l = *edges; l; l = g_list_next (l))
+    {
+      _NodeEdge *edge = l->data;
+      *nodes = g_list_remove (*nodes, edge->successor);
+    }
+
+  while (*nodes)
+    {
+      gpointer n = (*nodes)->data;
+
+      *nodes = g_list_delete_link (*nodes, *nodes);
+      sorted_nodes = g_list_prepend (sorted_nodes, n);
+
+      for (l = *edges; l; l = next)
+        {
+          _NodeEdge *edge = l->data;
+
+          next = g_list_next (l);
+
+          if (edge->predecessor == n)
+            {
+              *edges = g_list_delete_link (*edges, l);
+
+              if (reference_tsort_has_no_incoming_edge (edge->successor, *edges))
+                *nodes = g_list_prepend (*nodes, edge->successor);
+
+              g_slice_free (_NodeEdge, edge);
+            }
+        }
+    }
+
+  return g_list_reverse (sorted_nodes);
+}
+
+static void
+random_graph (GRand   *rand,
+              guint    n_nodes,
+              guint    n_edges,
+              gboolean acyclic,
+              GList  **nodes,
+              GList  **edges)
+{
+  guint i;
+
+  *nodes = NULL;
+  *edges = NULL;
+
+  for (i = 1; i <= n_nodes; i++)
+    *nodes = g_list_prepend (*nodes, GUINT_TO_POINTER (i));
+
+  for (i = 0; i < n_edges; i++)
+    {
+      /* Allow one extra node which is only present in the edges */
+      guint a = g_rand_int_range (rand, 1, n_nodes + 2);
+      guint b = g_rand_int_range (rand, 1, n_nodes + 2);
+
+      if (acyclic && a == b)
+        continue;
+
+      if (acyclic && a > b)
+        *edges = _node_edge_prepend (*edges, GUINT_TO_POINTER (b), GUINT_TO_POINTER (a));
+      else
+        *edges = _node_edge_prepend (*edges, GUINT_TO_POINTER (a), GUINT_TO_POINTER (b));
+    }
+}
+
+static GList *
+copy_edges (GList *edges)
+{
+  GList *l, *copy = NULL;
+
+  for (l = g_list_last (edges); l; l = g_list_previous (l))
+    {
+      _NodeEdge *edge = l->data;
+      copy = _node_edge_prepend (copy, edge->predecessor, edge->successor);
+    }
+
+  return copy;
+}
+
+static void
+test_tsort_reference (void)
+{
+  GRand *rand = g_rand_new_with_seed (1234);
+  guint i;
+
+  for (i = 0; i < 200; i++)
+    {
+      GList *nodes, *edges, *ref_nodes, *ref_edges;
+      GList *sorted, *ref_sorted, *l, *ll;
+      guint n_nodes = g_rand_int_range (rand, 1, 40);
+      guint n_edges = g_rand_int_range (rand, 0, 80);
+
+      random_graph (rand, n_nodes, n_edges, i % 2, &nodes, &edges);
+      ref_nodes = g_list_copy (nodes);
+      ref_edges = copy_edges (edges);
+
+      sorted = _glade_tsort (&nodes, &edges);
+      ref_sorted = reference_tsort (&ref_nodes, &ref_edges);
+
+      g_assert_null (nodes);
+      g_assert_cmpuint (g_list_length (sorted), ==, g_list_length (ref_sorted));
+      for (l = sorted, ll = ref_sorted; l && ll; l = l->next, ll = ll->next)
+        g_assert_true (l->data == ll->data);
+
+      /* Cycles are left in the same order */
+      g_assert_cmpuint (g_list_length (edges), ==, g_list_length (ref_edges));
+      for (l = edges, ll = ref_edges; l && ll; l = l->next, ll = ll->next)
+        {
+          _NodeEdge *edge = l->data, *ref_edge = ll->data;
+
+          g_assert_true (edge->predecessor == ref_edge->predecessor);
+          g_assert_true (edge->successor == ref_edge->successor);
+        }
+
+      g_list_free (sorted);
+      g_list_free (ref_sorted);
+      _node_edge_list_free (edges);
+      _node_edge_list_free (ref_edges);
+    }
+
+  g_rand_free (rand);
+}
+
+static void
+test_tsort_time (gconstpointer data)
+{
+  guint n_nodes = GPOINTER_TO_UINT (data);
+  GRand *rand = g_rand_new_with_seed (n_nodes);
+  GList *nodes, *edges, *sorted;
+  gdouble elapsed;
+
+  random_graph (rand, n_nodes, n_nodes * 4, TRUE, &nodes, &edges);
+
+  g_test_timer_start ();
+  sorted = _glade_tsort (&nodes, &edges);
+  elapsed = g_test_timer_elapsed ();
+
+  g_test_minimized_result (elapsed, "Sorted %u nodes with %u edges in %.3f seconds",
+                           n_nodes, n_nodes * 4, elapsed);
+
+  g_assert_null (edges);
+
+  g_list_free (sorted);
+  g_rand_free (rand);
+}
+
+/* Writes a project with @n_groups groups of ten spin buttons toplevels, each
+ * one with its own adjustment and sharing a size group, plus a tree view
+ * toplevel referencing a list store.
+ */
+static gchar *
+write_references_project (guint n_groups)
+{
+  GString *xml = g_string_new ("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                               "<interface>\n"
+                               "  <requires lib=\"gtk+\" version=\"3.24\"/>\n");
+  gchar *path;
+  guint i, j;
+
+  for (i = 0; i < n_groups; i++)
+    {
+      for (j = i * 10; j < (i + 1) * 10; j++)
+        g_string_append_printf (xml,
+                                "  <object class=\"GtkAdjustment\" id=\"adjustment%u\">\n"
+                                "    <property name=\"upper\">100</property>\n"
+                                "  </object>\n"
+                                "  <object class=\"GtkSpinButton\" id=\"spinbutton%u\">\n"
+                                "    <property name=\"visible\">True</property>\n"
+                                "    <property name=\"adjustment\">adjustment%u</property>\n"
+                                "  </object>\n",
+                                j, j, j);
+
+      g_string_append_printf (xml,
+                              "  <object class=\"GtkSizeGroup\" id=\"sizegroup%u\">\n"
+                              "    <widgets>\n", i);
+      for (j = i * 10; j < (i + 1) * 10; j++)
+        g_string_append_printf (xml, "      <widget name=\"spinbutton%u\"/>\n", j);
+      g_string_append (xml, "    </widgets>\n  </object>\n");
+
+      g_string_append_printf (xml,
+                              "  <object class=\"GtkListStore\" id=\"liststore%u\">\n"
+                              "    <columns>\n"
+                              "      <column type=\"gchararray\"/>\n"
+                              "    </columns>\n"
+                              "  </object>\n"
+                              "  <object class=\"GtkTreeView\" id=\"treeview%u\">\n"
+                              "    <property name=\"visible\">True</property>\n"
+                              "    <property name=\"model\">liststore%u</property>\n"
+                              "  </object>\n",
+                              i, i, i);
+    }
+
+  g_string_append (xml, "</interface>\n");
+
+  g_assert_true (g_close (g_file_open_tmp ("glade-toplevel-order-XXXXXX.glade", &path, NULL), NULL));
+  g_assert_true (g_file_set_contents (path, xml->str, xml->len, NULL));
+  g_string_free (xml, TRUE);
+
+  return path;
+}
+
+static void
+test_save_time (gconstpointer data)
+{
+  guint n_groups = GPOINTER_TO_UINT (data);
+  GladeProject *project;
+  gdouble elapsed;
+  gchar *path;
+
+  path = write_references_project (n_groups);
+  g_assert_true ((project = glade_project_load (path)));
+
+  g_test_timer_start ();
+  g_assert_true (glade_project_save (project, path, NULL));
+  elapsed = g_test_timer_elapsed ();
+
+  /* Ten adjustments and spin buttons, a size group, a list store and a tree view */
+  g_test_minimized_result (elapsed, "Saved %u toplevels in %.3f seconds",
+                           n_groups * 23, elapsed);
+
+  g_object_unref (project);
+  g_unlink (path);
+  g_free (path);
+}
+
+static void
+add_perf_test (const gchar *name, GTestDataFunc func, guint size)
+{
+  gchar *test_path = g_strdup_printf ("/ToplevelOrder/Perf/%s/%u", name, size);
+
+  g_test_add_data_func (test_path, GUINT_TO_POINTER (size), func);
+  g_free (test_path);
+}
+
 static void
 test_toplevel_order (gconstpointer userdata)
 {
@@ -151,6 +410,7 @@ main (int argc, char *argv[])
   glade_app_get ();
 
   add_tsort_test (tsort_test, tsort_test_edges);
+  g_test_add_func ("/Tsort/Reference", test_tsort_reference);
   
   add_project_test (order_test);
   add_project_test (order_test2);
@@ -158,6 +418,16 @@ main (int argc, char *argv[])
   add_project_test (order_test4);
   add_project_test (order_test5);
   add_project_test (order_test6);
+
+  /* Benchmarks, run with -m perf */
+  if (g_test_perf ())
+    {
+      add_perf_test ("Tsort", test_tsort_time, 1000);
+      add_perf_test ("Tsort", test_tsort_time, 10000);
+      add_perf_test ("Tsort", test_tsort_time, 100000);
+      add_perf_test ("Save", test_save_time, 100);
+      add_perf_test ("Save", test_save_time, 500);
+    }
   
   return g_test_run ();
 }
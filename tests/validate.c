@@ -0,0 +1,86 @@
+#include <string.h>
+
+#include <glib.h>
+#include <gio/gio.h>
+
+/* Runs glade-validate with @jobs processes on the fixtures and a missing
+ * file, returns its report lines.
+ */
+static gchar **
+run_validate (const gchar *jobs)
+{
+  GSubprocess *process;
+  GError *error = NULL;
+  gchar *ok, *problems, *output = NULL, **lines;
+
+  ok = g_test_build_filename (G_TEST_DIST, "validate_ok.glade", NULL);
+  problems = g_test_build_filename (G_TEST_DIST, "validate_problems.glade", NULL);
+
+  process = g_subprocess_new (G_SUBPROCESS_FLAGS_STDOUT_PIPE, &error,
+                              g_getenv ("GLADE_VALIDATE"), "--jobs", jobs,
+                              ok, problems, "validate_missing.glade", ok, NULL);
+  g_assert_no_error (error);
+  g_assert_true (g_subprocess_communicate_utf8 (process, NULL, NULL, &output, NULL, &error));
+  g_assert_no_error (error);
+
+  /* Not every file is fine */
+  g_assert_true (g_subprocess_get_if_exited (process));
+  g_assert_cmpint (g_subprocess_get_exit_status (process), ==, 1);
+
+  lines = g_strsplit (output, "\n", -1);
+
+  g_object_unref (process);
+  g_free (output);
+  g_free (problems);
+  g_free (ok);
+
+  return lines;
+}
+
+static void
+assert_report (const gchar *line, const gchar *file, const gchar *status)
+{
+  gchar *expected;
+
+  g_assert_true (g_str_has_prefix (line, "{\"file\":\""));
+  g_assert_true (g_str_has_suffix (line, "]}"));
+  g_assert_nonnull (strstr (line, file));
+
+  expected = g_strdup_printf (",\"status\":\"%s\"", status);
+  g_assert_nonnull (strstr (line, expected));
+  g_free (expected);
+}
+
+/* Reports are JSON Lines, one per file in command line order and a
+ * summary, whether the files are validated in workers or not.
+ */
+static void
+test_report (gconstpointer data)
+{
+  gchar **lines = run_validate (data);
+
+  g_assert_cmpuint (g_strv_length (lines), ==, 6);
+
+  assert_report (lines[0], "validate_ok.glade", "ok");
+  assert_report (lines[1], "validate_problems.glade", "problems");
+  g_assert_nonnull (strstr (lines[1], "GladeTestUnknown"));
+  assert_report (lines[2], "validate_missing.glade", "error");
+  assert_report (lines[3], "validate_ok.glade", "ok");
+
+  g_assert_true (g_str_has_prefix (lines[4],
+                                   "{\"summary\":{\"files\":4,\"ok\":2,\"problems\":1,\"errors\":1,"));
+  g_assert_cmpstr (lines[5], ==, "");
+
+  g_strfreev (lines);
+}
+
+int
+main (int argc, char *argv[])
+{
+  g_test_init (&argc, &argv, NULL);
+
+  g_test_add_data_func ("/Validate/Report", "1", test_report);
+  g_test_add_data_func ("/Validate/ReportWorkers", "2", test_report);
+
+  return g_test_run ();
+}
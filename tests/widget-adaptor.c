@@ -0,0 +1,273 @@
+#include <glib.h>
+#include <glib/gstdio.h>
+#include <glib-object.h>
+
+#include <gladeui/glade-app.h>
+#include <gladeui/glade-private.h>
+
+#include "test-utils.h"
+
+#define N_LOOKUP_ROUNDS 100
+
+static GladePropertyDef *
+find_property_def (const GList *properties, const gchar *id)
+{
+  const GList *l;
+
+  for (l = properties; l; l = l->next)
+    if (g_strcmp0 (glade_property_def_id (l->data), id) == 0)
+      return l->data;
+
+  return NULL;
+}
+
+static GladeSignalDef *
+find_signal_def (const GList *signals, const gchar *name)
+{
+  const GList *l;
+
+  for (l = signals; l; l = l->next)
+    if (g_strcmp0 (glade_signal_def_get_name (l->data), name) == 0)
+      return l->data;
+
+  return NULL;
+}
+
+/* Looks up every definition of every registered adaptor, and returns
+ * the amount of lookups done.
+ */
+static guint
+lookup_all_defs (gboolean check)
+{
+  GList *adaptors, *l;
+  const GList *d;
+  guint n_lookups = 0;
+
+  adaptors = glade_widget_adaptor_list_adaptors ();
+
+  for (l = adaptors; l; l = l->next)
+    {
+      GladeWidgetAdaptor *adaptor = l->data;
+      const GList *properties = glade_widget_adaptor_get_properties (adaptor);
+      const GList *packing_props = glade_widget_adaptor_get_packing_props (adaptor);
+      const GList *signals = glade_widget_adaptor_get_signals (adaptor);
+
+      for (d = properties; d; d = d->next, n_lookups++)
+        {
+          const gchar *id = glade_property_def_id (d->data);
+          GladePropertyDef *pdef = glade_widget_adaptor_get_property_def (adaptor, id);
+
+          if (check)
+            g_assert_true (pdef == find_property_def (properties, id));
+        }
+
+      for (d = packing_props; d; d = d->next, n_lookups++)
+        {
+          const gchar *id = glade_property_def_id (d->data);
+          GladePropertyDef *pdef = glade_widget_adaptor_get_pack_property_def (adaptor, id);
+
+          if (check)
+            g_assert_true (pdef == find_property_def (packing_props, id));
+        }
+
+      for (d = signals; d; d = d->next, n_lookups++)
+        {
+          const gchar *name = glade_signal_def_get_name (d->data);
+          GladeSignalDef *sdef = glade_widget_adaptor_get_signal_def (adaptor, name);
+
+          if (check)
+            g_assert_true (sdef == find_signal_def (signals, name));
+        }
+
+      if (check)
+        {
+          g_assert_null (glade_widget_adaptor_get_property_def (adaptor, "not-a-property"));
+          g_assert_null (glade_widget_adaptor_get_pack_property_def (adaptor, "not-a-property"));
+          g_assert_null (glade_widget_adaptor_get_signal_def (adaptor, "not-a-signal"));
+        }
+    }
+
+  g_list_free (adaptors);
+
+  return n_lookups;
+}
+
+static void
+test_def_lookup (void)
+{
+  g_test_log_set_fatal_handler (test_utils_ignore_gvfs_warning, NULL);
+
+  g_assert_cmpuint (lookup_all_defs (TRUE), >, 0);
+}
+
+static void
+test_lazy_definitions (void)
+{
+  GladeWidgetAdaptor *adaptor, *parent;
+  GladePropertyDef *pdef;
+
+  g_test_log_set_fatal_handler (test_utils_ignore_gvfs_warning, NULL);
+
+  /* Registered adaptors only build their definitions when first needed */
+  adaptor = glade_widget_adaptor_get_by_type (GTK_TYPE_VOLUME_BUTTON);
+  parent = glade_widget_adaptor_get_parent_adaptor (adaptor);
+  g_assert_true (parent == glade_widget_adaptor_get_by_type (GTK_TYPE_SCALE_BUTTON));
+  g_assert_false (_glade_widget_adaptor_is_materialized (adaptor));
+  g_assert_cmpstr (glade_widget_adaptor_get_title (adaptor), ==, "Volume Button");
+
+  pdef = glade_widget_adaptor_get_property_def (adaptor, "use-symbolic");
+  g_assert_nonnull (pdef);
+  g_assert_true (glade_property_def_custom_layout (pdef));
+  g_assert_true (_glade_widget_adaptor_is_materialized (adaptor));
+
+  /* Parent adaptors are built first, with their catalog overrides */
+  g_assert_true (_glade_widget_adaptor_is_materialized (parent));
+  pdef = glade_widget_adaptor_get_property_def (adaptor, "icons");
+  g_assert_nonnull (pdef);
+  g_assert_true (glade_property_def_custom_layout (pdef));
+  g_assert_true (glade_property_def_get_adaptor (pdef) == adaptor);
+  g_assert_true (pdef != glade_widget_adaptor_get_property_def (parent, "icons"));
+  g_assert_nonnull (glade_widget_adaptor_get_signal_def (adaptor, "value-changed"));
+}
+
+static void
+assert_property_slots (GladeWidget *widget, const GList *properties, gboolean packing)
+{
+  const GList *l;
+
+  for (l = properties; l; l = l->next)
+    {
+      const gchar *id = glade_property_def_id (glade_property_get_def (l->data));
+
+      if (packing)
+        g_assert_true (glade_widget_get_pack_property (widget, id) == l->data);
+      else
+        g_assert_true (glade_widget_get_property (widget, id) == l->data);
+    }
+}
+
+static void
+test_property_slots (void)
+{
+  GladeWidget *box, *button;
+
+  g_test_log_set_fatal_handler (test_utils_ignore_gvfs_warning, NULL);
+
+  box = glade_widget_adaptor_create_widget (glade_widget_adaptor_get_by_type (GTK_TYPE_BOX),
+                                            FALSE, NULL);
+  button = glade_widget_adaptor_create_widget (glade_widget_adaptor_get_by_type (GTK_TYPE_BUTTON),
+                                               FALSE, NULL);
+  glade_widget_add_child (box, button, FALSE);
+  g_object_unref (button);
+
+  /* Every property is found through its slot */
+  assert_property_slots (button, glade_widget_get_properties (button), FALSE);
+  assert_property_slots (button, glade_widget_get_packing_properties (button), TRUE);
+  g_assert_null (glade_widget_get_property (button, "not-a-property"));
+  g_assert_null (glade_widget_get_pack_property (button, "not-a-property"));
+
+  /* Packing properties are looked up after the regular ones */
+  g_assert_true (glade_widget_get_property (button, "position") ==
+                 glade_widget_get_pack_property (button, "position"));
+
+  /* Removed properties leave an empty slot behind */
+  glade_widget_remove_property (button, "label");
+  g_assert_null (glade_widget_get_property (button, "label"));
+  assert_property_slots (button, glade_widget_get_properties (button), FALSE);
+
+  g_object_unref (box);
+}
+
+static void
+test_def_lookup_time (void)
+{
+  gdouble elapsed;
+  guint i, n_lookups = 0;
+
+  g_test_log_set_fatal_handler (test_utils_ignore_gvfs_warning, NULL);
+
+  g_test_timer_start ();
+  for (i = 0; i < N_LOOKUP_ROUNDS; i++)
+    n_lookups += lookup_all_defs (FALSE);
+  elapsed = g_test_timer_elapsed ();
+
+  g_test_minimized_result (elapsed, "Looked up %u definitions in %.3f seconds",
+                           n_lookups, elapsed);
+}
+
+/* Reads a project with @data buttons packed in a box, each one with a
+ * handler, so every property, packing property and signal read goes
+ * through the adaptor lookups.
+ */
+static void
+test_load_time (gconstpointer data)
+{
+  guint n_buttons = GPOINTER_TO_UINT (data);
+  GladeProject *project;
+  GString *xml;
+  gdouble elapsed;
+  gchar *path;
+  guint i;
+
+  g_test_log_set_fatal_handler (test_utils_ignore_gvfs_warning, NULL);
+
+  xml = g_string_new (TEST_UTILS_UI_HEADER
+                      "  <object class=\"GtkBox\" id=\"box\">\n"
+                      "    <property name=\"visible\">True</property>\n"
+                      "    <property name=\"orientation\">vertical</property>\n");
+
+  for (i = 0; i < n_buttons; i++)
+    g_string_append_printf (xml,
+                            "    <child>\n"
+                            "      <object class=\"GtkButton\" id=\"button%u\">\n"
+                            "        <property name=\"label\">button%u</property>\n"
+                            "        <property name=\"visible\">True</property>\n"
+                            "        <property name=\"receives_default\">True</property>\n"
+                            "        <signal name=\"clicked\" handler=\"on_button%u_clicked\"/>\n"
+                            "      </object>\n"
+                            "      <packing>\n"
+                            "        <property name=\"expand\">False</property>\n"
+                            "        <property name=\"fill\">True</property>\n"
+                            "        <property name=\"position\">%u</property>\n"
+                            "      </packing>\n"
+                            "    </child>\n",
+                            i, i, i, i);
+
+  g_string_append (xml, "  </object>\n" TEST_UTILS_UI_FOOTER);
+
+  path = test_utils_write_project (xml->str);
+  g_string_free (xml, TRUE);
+
+  g_test_timer_start ();
+  g_assert_true ((project = glade_project_load (path)));
+  elapsed = g_test_timer_elapsed ();
+
+  g_test_minimized_result (elapsed, "Loaded %u buttons in %.3f seconds",
+                           n_buttons, elapsed);
+
+  g_object_unref (project);
+  g_unlink (path);
+  g_free (path);
+}
+
+int
+main (int argc, char *argv[])
+{
+  gtk_test_init (&argc, &argv, NULL);
+
+  glade_init ();
+  glade_app_get ();
+
+  g_test_add_func ("/WidgetAdaptor/LazyDefinitions", test_lazy_definitions);
+  g_test_add_func ("/WidgetAdaptor/DefLookup", test_def_lookup);
+  g_test_add_func ("/WidgetAdaptor/PropertySlots", test_property_slots);
+
+  /* Benchmarks, run with -m perf */
+  if (g_test_perf ())
+    {
+      g_test_add_func ("/WidgetAdaptor/DefLookup/Time", test_def_lookup_time);
+      g_test_add_data_func ("/WidgetAdaptor/LoadTime/5000", GUINT_TO_POINTER (5000), test_load_time);
+    }
+
+  return g_test_run ();
+}